@@ -34,6 +34,8 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/timestepping/gatherConvergenceReport.cpp
   opm/simulators/utils/DeferredLogger.cpp
   opm/simulators/utils/gatherDeferredLogger.cpp
+  opm/simulators/utils/MaxSumReduction.cpp
+  opm/simulators/utils/MemoryReport.cpp
   opm/simulators/utils/moduleVersion.cpp
   opm/simulators/utils/ParallelRestart.cpp
   opm/simulators/wells/VFPProdProperties.cpp
@@ -47,8 +49,10 @@ if(CUDA_FOUND)
   list (APPEND MAIN_SOURCE_FILES opm/simulators/linalg/bda/BdaBridge.cpp)
 endif()
 if(MPI_FOUND)
-  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/ParallelEclipseState.cpp
-                                opm/simulators/utils/ParallelSerialization.cpp)
+  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/DeckCache.cpp
+                                opm/simulators/utils/ParallelEclipseState.cpp
+                                opm/simulators/utils/ParallelSerialization.cpp
+                                opm/simulators/utils/RankCheckpoint.cpp)
 endif()
 
 # originally generated with the command:
@@ -63,11 +67,15 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_graphcoloring.cpp
   tests/test_vfpproperties.cpp
   tests/test_milu.cpp
+  tests/test_mswellhelpers.cpp
   tests/test_multmatrixtransposed.cpp
   tests/test_nncsorter.cpp
   tests/test_wellmodel.cpp
   tests/test_deferredlogger.cpp
   tests/test_timer.cpp
+  tests/test_memoryreport.cpp
+  tests/test_regionaggregator.cpp
+  tests/test_partitioncells.cpp
   tests/test_invert.cpp
   tests/test_stoppedwells.cpp
   tests/test_relpermdiagnostics.cpp
@@ -76,8 +84,8 @@ list (APPEND TEST_SOURCE_FILES
   )
 
 if(MPI_FOUND)
-  list(APPEND TEST_SOURCE_FILES tests/test_parallelistlinformation.cpp
-                                tests/test_ParallelRestart.cpp)
+  list(APPEND TEST_SOURCE_FILES tests/test_ParallelRestart.cpp
+                                tests/test_rankcheckpoint.cpp)
 endif()
 
 list (APPEND TEST_DATA_FILES
@@ -127,6 +135,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/FlowMainEbos.hpp
   opm/simulators/flow/Main.hpp
   opm/simulators/flow/NonlinearSolverEbos.hpp
+  opm/simulators/flow/partitionCells.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/MissingFeatures.hpp
   opm/core/props/BlackoilPhases.hpp
@@ -145,6 +154,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/cuda_header.hpp
   opm/simulators/linalg/bda/cusparseSolverBackend.hpp
   opm/simulators/linalg/bda/WellContributions.hpp
+  opm/simulators/linalg/AmgAccumulation.hpp
   opm/simulators/linalg/BlackoilAmg.hpp
   opm/simulators/linalg/amgcpr.hh
   opm/simulators/linalg/twolevelmethodcpr.hh
@@ -161,6 +171,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/ParallelOverlappingILU0.hpp
   opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp
   opm/simulators/linalg/ParallelIstlInformation.hpp
+  opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp
   opm/simulators/linalg/PressureSolverPolicy.hpp
   opm/simulators/linalg/PressureTransferPolicy.hpp
   opm/simulators/linalg/PreconditionerFactory.hpp
@@ -178,13 +189,18 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/timestepping/SimulatorTimerInterface.hpp
   opm/simulators/timestepping/gatherConvergenceReport.hpp
   opm/simulators/utils/ParallelFileMerger.hpp
+  opm/simulators/utils/DeckCache.hpp
   opm/simulators/utils/DeferredLoggingErrorHelpers.hpp
   opm/simulators/utils/DeferredLogger.hpp
   opm/simulators/utils/gatherDeferredLogger.hpp
+  opm/simulators/utils/MaxSumReduction.hpp
+  opm/simulators/utils/MemoryReport.hpp
   opm/simulators/utils/moduleVersion.hpp
   opm/simulators/utils/ParallelEclipseState.hpp
   opm/simulators/utils/ParallelRestart.hpp
+  opm/simulators/utils/RegionAggregator.hpp
   opm/simulators/utils/PropsCentroidsDataHandle.hpp
+  opm/simulators/utils/RankCheckpoint.hpp
   opm/simulators/wells/PerforationData.hpp
   opm/simulators/wells/RateConverter.hpp
   opm/simulators/wells/SimFIBODetails.hpp
@@ -708,6 +708,10 @@ public:
     const Opm::data::Solution& globalCellData() const
     { return globalCellData_; }
 
+    // the cell data is reset by the next collect(), so it may be moved from
+    Opm::data::Solution& globalCellData()
+    { return globalCellData_; }
+
     const Opm::data::Wells& globalWellData() const
     { return globalWellData_; }
 
@@ -33,11 +33,13 @@
 
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/cpgrid/GridHelpers.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
 #include <opm/simulators/utils/PropsCentroidsDataHandle.hpp>
 
 #include <dune/grid/common/mcmgmapper.hh>
 
+#include <dune/common/timer.hh>
 #include <dune/common/version.hh>
 
 #include <sstream>
@@ -56,6 +58,8 @@ SET_TYPE_PROP(EclCpGridVanguard, Vanguard, Opm::EclCpGridVanguard<TypeTag>);
 SET_TYPE_PROP(EclCpGridVanguard, Grid, Dune::CpGrid);
 SET_TYPE_PROP(EclCpGridVanguard, EquilGrid, typename GET_PROP_TYPE(TypeTag, Grid));
 
+NEW_PROP_TAG(EnableEclOutput);
+
 END_PROPERTIES
 
 namespace Opm {
@@ -127,7 +131,8 @@ public:
      *        by the EQUIL grid can be released.
      *
      * Depending on the implementation, subsequent accesses to the EQUIL grid lead to
-     * crashes.
+     * crashes. The EQUIL grid is a shallow copy of the global view of the simulation
+     * grid, which keeps that view, so only the Cartesian index mapper is freed here.
      */
     void releaseEquilGrid()
     {
@@ -152,41 +157,26 @@ public:
             // transmissibilities are relatively expensive to compute, we only do it if
             // more than a single process is involved in the simulation.
             cartesianIndexMapper_.reset(new CartesianIndexMapper(*grid_));
-            if (grid_->size(0))
-            {
-                globalTrans_.reset(new EclTransmissibility<TypeTag>(*this));
-                globalTrans_->update(false);
-            }
 
             Dune::EdgeWeightMethod edgeWeightsMethod = this->edgeWeightsMethod();
             bool ownersFirst = this->ownersFirst();
 
-            // convert to transmissibility for faces
-            // TODO: grid_->numFaces() is not generic. use grid_->size(1) instead? (might
-            // not work)
-            const auto& gridView = grid_->leafGridView();
-            unsigned numFaces = grid_->numFaces();
-            std::vector<double> faceTrans(numFaces, 0.0);
-            ElementMapper elemMapper(this->gridView(), Dune::mcmgElementLayout());
-            auto elemIt = gridView.template begin</*codim=*/0>();
-            const auto& elemEndIt = gridView.template end</*codim=*/0>();
-            for (; elemIt != elemEndIt; ++ elemIt) {
-                const auto& elem = *elemIt;
-                auto isIt = gridView.ibegin(elem);
-                const auto& isEndIt = gridView.iend(elem);
-                for (; isIt != isEndIt; ++ isIt) {
-                    const auto& is = *isIt;
-                    if (!is.neighbor())
-                        continue;
-
-                    unsigned I = elemMapper.index(is.inside());
-                    unsigned J = elemMapper.index(is.outside());
-
-                    // FIXME (?): this is not portable!
-                    unsigned faceIdx = is.id();
-
-                    faceTrans[faceIdx] = globalTrans_->transmissibility(I, J);
-                }
+            // the global transmissibilities are needed on the I/O rank either for the
+            // edge weights or for writing the INIT file. if neither is the case, we can
+            // avoid computing them altogether.
+            const bool needTransForWeights = edgeWeightsMethod != Dune::uniformEdgeWgt;
+            const bool needTransForOutput = EWOMS_GET_PARAM(TypeTag, bool, EnableEclOutput);
+            if (grid_->size(0) && (needTransForWeights || needTransForOutput))
+            {
+                Dune::Timer transTimer;
+                globalTrans_.reset(new EclTransmissibility<TypeTag>(*this));
+                globalTrans_->update(false);
+                transTimer.stop();
+                const std::string purpose = needTransForWeights
+                    ? (needTransForOutput ? "load balancing and output" : "load balancing")
+                    : "output";
+                OpmLog::info("Computed global transmissibilities for " + purpose + " in "
+                             + std::to_string(transTimer.elapsed()) + " seconds");
             }
 
             //distribute the grid and switch to the distributed view.
@@ -203,6 +193,10 @@ public:
                         eclGrid = &this->eclState().getInputGrid();
                     }
 
+                    // the face weights are only needed while partitioning. keeping
+                    // them in this scope frees them before switching to the distributed view.
+                    std::vector<double> faceTrans = computeEdgeWeights_(edgeWeightsMethod);
+
                     PropsCentroidsDataHandle<Dune::CpGrid> handle(*grid_, eclState, eclGrid, this->centroids_,
                                                                   cartesianIndexMapper());
                     defunctWellNames_ = std::get<1>(grid_->loadBalance(handle, edgeWeightsMethod, &wells, faceTrans.data(), ownersFirst));
@@ -218,6 +212,14 @@ public:
             }
             grid_->switchToDistributedView();
 
+            if (globalTrans_ && !needTransForOutput)
+            {
+                // nobody is going to write the INIT file, so there is no reason to
+                // keep the global transmissibilities until the end of initialization.
+                globalTrans_.reset();
+                OpmLog::info("Released global transmissibilities after load balancing");
+            }
+
             cartesianIndexMapper_.reset();
 
             if ( ! equilGrid_ )
@@ -296,7 +298,90 @@ public:
         globalTrans_.reset();
     }
 
+    /*!
+     * \brief Adds the memory used by the grid and the global transmissibilities.
+     *
+     * The size of the grid is estimated from the numbers of its cells, faces and
+     * vertices of the current view. The EQUIL grid shares its data with the global
+     * view of the simulation grid and is not counted separately.
+     */
+    void addMemoryUsage(MemoryReport& report) const
+    {
+        report.add("Grid", gridMemoryUsage_(*grid_));
+        report.add("Transmissibilities", globalTrans_ ? globalTrans_->memoryUsage() : 0);
+    }
+
 protected:
+    static std::size_t gridMemoryUsage_(const Dune::CpGrid& grid)
+    {
+        // cells: centroid, volume, global index and face orientation; faces:
+        // centroid, normal, area, tag, neighbors and about four vertices; vertices:
+        // coordinates
+        const std::size_t numCells = UgGridHelpers::numCells(grid);
+        const std::size_t numFaces = UgGridHelpers::numFaces(grid);
+        const std::size_t numCellFaces = UgGridHelpers::numCellFaces(grid);
+        const std::size_t numVertices = grid.size(Grid::dimension);
+        return numCells*(4*sizeof(double) + sizeof(int))
+            + numCellFaces*2*sizeof(int)
+            + numFaces*(7*sizeof(double) + 7*sizeof(int))
+            + numVertices*3*sizeof(double);
+    }
+
+#if HAVE_MPI
+    /*!
+     * \brief Compute the edge weights of the faces of the global grid which are passed
+     *        to the partitioner.
+     *
+     * For uniform edge weights, the transmissibilities are not required at all. For the
+     * other methods each face is only visited once, i.e., from the cell with the
+     * smaller index.
+     */
+    std::vector<double> computeEdgeWeights_(Dune::EdgeWeightMethod edgeWeightsMethod) const
+    {
+        // TODO: grid_->numFaces() is not generic. use grid_->size(1) instead? (might
+        // not work)
+        unsigned numFaces = grid_->numFaces();
+        if (edgeWeightsMethod == Dune::uniformEdgeWgt || !globalTrans_)
+            return std::vector<double>(numFaces, 1.0);
+
+        Dune::Timer edgeWeightTimer;
+        std::vector<double> faceTrans(numFaces, 0.0);
+        const auto& gridView = grid_->leafGridView();
+        ElementMapper elemMapper(this->gridView(), Dune::mcmgElementLayout());
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++ elemIt) {
+            const auto& elem = *elemIt;
+            auto isIt = gridView.ibegin(elem);
+            const auto& isEndIt = gridView.iend(elem);
+            for (; isIt != isEndIt; ++ isIt) {
+                const auto& is = *isIt;
+                if (!is.neighbor())
+                    continue;
+
+                unsigned I = elemMapper.index(is.inside());
+                unsigned J = elemMapper.index(is.outside());
+                if (I > J)
+                    continue; // the face has already been handled from the other side
+
+                // FIXME (?): this is not portable!
+                unsigned faceIdx = is.id();
+
+                faceTrans[faceIdx] = globalTrans_->transmissibility(I, J);
+            }
+        }
+        edgeWeightTimer.stop();
+
+        std::ostringstream message;
+        message << "Computed " << numFaces << " edge weights for load balancing in "
+                << edgeWeightTimer.elapsed() << " seconds ("
+                << numFaces*sizeof(double)/(1024.0*1024.0) << " MB)";
+        OpmLog::info(message.str());
+
+        return faceTrans;
+    }
+#endif
+
     void createGrids_()
     {
         grid_.reset(new Dune::CpGrid());
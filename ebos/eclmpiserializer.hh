@@ -23,6 +23,11 @@
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
 namespace Opm {
 
 /*! \brief Class for (de-)serializing and broadcasting data in parallel.
@@ -52,9 +57,9 @@ public:
           if (m_op == Operation::PACKSIZE)
               m_packSize += Mpi::packSize(data, m_comm);
           else if (m_op == Operation::PACK)
-              Mpi::pack(data, m_buffer, m_position, m_comm);
+              packItem(data);
           else if (m_op == Operation::UNPACK)
-              Mpi::unpack(const_cast<T&>(data), m_buffer, m_position, m_comm);
+              unpackItem(const_cast<T&>(data));
         }
     }
 
@@ -83,11 +88,11 @@ public:
             m_packSize += Mpi::packSize(data.size(), m_comm);
             handle(data);
         } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.size(), m_buffer, m_position, m_comm);
+            packItem(data.size());
             handle(data);
         } else if (m_op == Operation::UNPACK) {
             size_t size;
-            Mpi::unpack(size, m_buffer, m_position, m_comm);
+            unpackItem(size);
             data.resize(size);
             handle(data);
         }
@@ -124,17 +129,17 @@ public:
                 handle(it.second);
             }
         } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.size(), m_buffer, m_position, m_comm);
+            packItem(data.size());
             for (auto& it : data) {
-                Mpi::pack(it.first, m_buffer, m_position, m_comm);
+                packItem(it.first);
                 handle(it.second);
             }
         } else if (m_op == Operation::UNPACK) {
             size_t size;
-            Mpi::unpack(size, m_buffer, m_position, m_comm);
+            unpackItem(size);
             for (size_t i = 0; i < size; ++i) {
                 Key key;
-                Mpi::unpack(key, m_buffer, m_position, m_comm);
+                unpackItem(key);
                 Data entry;
                 handle(entry);
                 data.insert(std::make_pair(key, entry));
@@ -169,6 +174,10 @@ public:
     }
 
     //! \brief Serialize and broadcast on root process, de-serialize on others.
+    //! \details The data is sent in chunks of fixed size while it is being
+    //!          serialized, and de-serialized while the next chunk is in
+    //!          transfer. Each process only holds two chunks, plus the
+    //!          largest single item if that does not fit into a chunk.
     //! \tparam T Type of class to broadcast
     //! \param data Class to broadcast
     template<class T>
@@ -177,17 +186,39 @@ public:
         if (m_comm.size() == 1)
             return;
 
+#if HAVE_MPI
+        m_chunked = true;
+        for (auto& chunk : m_chunks)
+            chunk.resize(m_chunkSize);
+        m_current = 0;
         if (m_comm.rank() == 0) {
-            pack(data);
-            m_packSize = m_position;
-            m_comm.broadcast(&m_packSize, 1, 0);
-            m_comm.broadcast(m_buffer.data(), m_position, 0);
+            m_op = Operation::PACK;
+            m_position = chunkHeaderSize;
+            data.serializeOp(*this);
+            sendChunk(ChunkType::LAST, m_position);
         } else {
-            m_comm.broadcast(&m_packSize, 1, 0);
-            m_buffer.resize(m_packSize);
-            m_comm.broadcast(m_buffer.data(), m_packSize, 0);
-            unpack(data);
+            m_op = Operation::UNPACK;
+            receiveChunk(m_current);
+            readChunk();
+            data.serializeOp(*this);
+            // the last chunk may not contain any data
+            while (m_chunkType != ChunkType::LAST)
+                nextChunk();
         }
+        MPI_Waitall(m_requests.size(), m_requests.data(), MPI_STATUSES_IGNORE);
+        m_chunked = false;
+        m_chunks = {};
+        m_item = {};
+#else
+        (void) data;
+#endif
+    }
+
+    //! \brief Set the size of the chunks used by broadcast().
+    //! \param chunkSize Chunk size in bytes
+    void setChunkSize(std::size_t chunkSize)
+    {
+        m_chunkSize = std::max(chunkSize, 2*chunkHeaderSize);
     }
 
     //! \brief Returns current position in buffer.
@@ -292,12 +323,162 @@ protected:
             data->serializeOp(*this);
     }
 
+    //! \brief Type of a chunk sent by broadcast().
+    enum class ChunkType : std::uint64_t {
+        DATA,  //!< Chunk holds whole items
+        LARGE, //!< Chunk starts a single item which spans several chunks
+        LAST   //!< Last chunk of the broadcast
+    };
+
+    //! \brief Every chunk starts with the end of its data and its type.
+    static constexpr std::size_t chunkHeaderSize = 2*sizeof(std::uint64_t);
+
+    //! \brief Serialize an item into the buffer, or into the chunks of a broadcast.
+    template<class T>
+    void packItem(const T& data)
+    {
+        if (!m_chunked) {
+            Mpi::pack(data, m_buffer, m_position, m_comm);
+            return;
+        }
+
+        const std::size_t size = Mpi::packSize(data, m_comm);
+        if (m_position + size > m_chunkSize) {
+            if (m_position > static_cast<int>(chunkHeaderSize))
+                sendChunk(ChunkType::DATA, m_position);
+            if (chunkHeaderSize + size > m_chunkSize) {
+                // an item larger than a chunk is split across several chunks
+                m_item.resize(size);
+                int position = 0;
+                Mpi::pack(data, m_item, position, m_comm);
+                sendLargeItem(position);
+                return;
+            }
+        }
+        Mpi::pack(data, m_chunks[m_current], m_position, m_comm);
+    }
+
+    //! \brief De-serialize an item from the buffer, or from the chunks of a broadcast.
+    template<class T>
+    void unpackItem(T& data)
+    {
+        if (!m_chunked) {
+            Mpi::unpack(data, m_buffer, m_position, m_comm);
+            return;
+        }
+
+        if (static_cast<std::size_t>(m_position) >= m_chunkEnd)
+            nextChunk();
+        if (m_chunkType == ChunkType::LARGE) {
+            receiveLargeItem();
+            int position = 0;
+            Mpi::unpack(data, m_item, position, m_comm);
+            return;
+        }
+        Mpi::unpack(data, m_chunks[m_current], m_position, m_comm);
+    }
+
+#if HAVE_MPI
+    //! \brief Start broadcasting the current chunk and switch to the other one.
+    //! \param type Type of the chunk
+    //! \param end End of the data in the chunk, the item size for ChunkType::LARGE
+    void sendChunk(ChunkType type, const std::uint64_t end)
+    {
+        const std::uint64_t header[2] = { end, static_cast<std::uint64_t>(type) };
+        std::memcpy(m_chunks[m_current].data(), header, chunkHeaderSize);
+        MPI_Ibcast(m_chunks[m_current].data(), static_cast<int>(m_chunkSize), MPI_BYTE, 0,
+                   m_comm, &m_requests[m_current]);
+        m_current = 1 - m_current;
+        // the other chunk is refilled once its broadcast is done
+        MPI_Wait(&m_requests[m_current], MPI_STATUS_IGNORE);
+        m_position = chunkHeaderSize;
+    }
+
+    //! \brief Broadcast the item in m_item using as many chunks as needed.
+    void sendLargeItem(const std::size_t size)
+    {
+        const std::size_t payload = m_chunkSize - chunkHeaderSize;
+        for (std::size_t offset = 0; offset < size; offset += payload) {
+            const std::size_t count = std::min(payload, size - offset);
+            std::memcpy(m_chunks[m_current].data() + chunkHeaderSize,
+                        m_item.data() + offset, count);
+            // the first chunk holds the item size, the others only data
+            if (offset == 0)
+                sendChunk(ChunkType::LARGE, size);
+            else
+                sendChunk(ChunkType::DATA, chunkHeaderSize + count);
+        }
+    }
+
+    //! \brief Start receiving the next chunk of the broadcast into the given buffer.
+    void receiveChunk(const int chunk)
+    {
+        MPI_Ibcast(m_chunks[chunk].data(), static_cast<int>(m_chunkSize), MPI_BYTE, 0,
+                   m_comm, &m_requests[chunk]);
+    }
+
+    //! \brief Wait for the current chunk, and start receiving the following one.
+    void readChunk()
+    {
+        MPI_Wait(&m_requests[m_current], MPI_STATUS_IGNORE);
+        std::uint64_t header[2];
+        std::memcpy(header, m_chunks[m_current].data(), chunkHeaderSize);
+        m_chunkEnd = header[0];
+        m_chunkType = static_cast<ChunkType>(header[1]);
+        m_position = chunkHeaderSize;
+        if (m_chunkType != ChunkType::LAST)
+            receiveChunk(1 - m_current);
+    }
+
+    //! \brief Switch to the next chunk once the current one is used up.
+    void nextChunk()
+    {
+        m_current = 1 - m_current;
+        readChunk();
+    }
+
+    //! \brief Collect an item which spans several chunks in m_item.
+    void receiveLargeItem()
+    {
+        const std::size_t payload = m_chunkSize - chunkHeaderSize;
+        const std::size_t size = m_chunkEnd;
+        m_item.resize(size);
+        for (std::size_t offset = 0; offset < size; offset += payload) {
+            if (offset > 0)
+                nextChunk();
+            const std::size_t count = std::min(payload, size - offset);
+            std::memcpy(m_item.data() + offset,
+                        m_chunks[m_current].data() + chunkHeaderSize, count);
+        }
+        // the next item starts in a new chunk
+        m_chunkType = ChunkType::DATA;
+        m_position = 0;
+        m_chunkEnd = 0;
+    }
+#else
+    void sendChunk(ChunkType, const std::uint64_t) {}
+    void sendLargeItem(const std::size_t) {}
+    void nextChunk() {}
+    void receiveLargeItem() {}
+#endif
+
     Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> m_comm; //!< Communicator to broadcast using
 
     Operation m_op = Operation::PACKSIZE; //!< Current operation
     size_t m_packSize = 0; //!< Required buffer size after PACKSIZE has been done
     int m_position = 0; //!< Current position in buffer
     std::vector<char> m_buffer; //!< Buffer for serialized data
+
+    bool m_chunked = false; //!< True while broadcasting in chunks
+    std::size_t m_chunkSize = 16*1024*1024; //!< Size of the chunks sent by broadcast()
+    std::array<std::vector<char>, 2> m_chunks; //!< Chunk in use and chunk in transfer
+#if HAVE_MPI
+    std::array<MPI_Request, 2> m_requests = {{ MPI_REQUEST_NULL, MPI_REQUEST_NULL }}; //!< Broadcasts of the chunks
+#endif
+    int m_current = 0; //!< Index of the chunk in use
+    std::size_t m_chunkEnd = 0; //!< End of the data in the received chunk
+    ChunkType m_chunkType = ChunkType::DATA; //!< Type of the received chunk
+    std::vector<char> m_item; //!< Buffer for items larger than a chunk
 };
 
 }
@@ -31,10 +31,20 @@
 #include <opm/models/blackoil/blackoilnewtonmethod.hh>
 #include <opm/models/utils/signum.hh>
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/simulators/utils/MaxSumReduction.hpp>
 
 
 #include <opm/material/common/Unused.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 BEGIN_PROPERTIES
 
 NEW_PROP_TAG(EclNewtonSumTolerance);
@@ -130,81 +140,135 @@ public:
         return this->error_ <= this->tolerance() && errorSum_ <= sumTolerance_;
     }
 
+    /*!
+     * \brief Update the primary variables of a subset of the degrees of
+     *        freedom.
+     *
+     * The update of the degree of freedom dofs[i] is update[i]. The update is
+     * chopped and the primary variables are switched just like in a global
+     * Newton update.
+     */
+    template <class DofList, class LocalUpdate>
+    void updateDofs(SolutionVector& solution,
+                    const DofList& dofs,
+                    const LocalUpdate& update)
+    {
+        for (std::size_t localIdx = 0; localIdx < dofs.size(); ++localIdx) {
+            const unsigned globalIdx = dofs[localIdx];
+            const PrimaryVariables currentValue(solution[globalIdx]);
+            EqVector dofUpdate;
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                dofUpdate[eqIdx] = update[localIdx][eqIdx];
+
+            this->updatePrimaryVariables_(globalIdx, solution[globalIdx], currentValue,
+                                          dofUpdate, dofUpdate);
+        }
+    }
+
     void preSolve_(const SolutionVector& currentSolution  OPM_UNUSED,
                    const GlobalEqVector& currentResidual)
     {
-        const auto& constraintsMap = this->model().linearizer().constraintsMap();
         this->lastError_ = this->error_;
         Scalar newtonMaxError = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonMaxError);
 
-        // calculate the error as the maximum weighted tolerance of
-        // the solution's residual
-        this->error_ = 0.0;
-        Dune::FieldVector<Scalar, numEq> componentSumError;
-        std::fill(componentSumError.begin(), componentSumError.end(), 0.0);
-        Scalar sumPv = 0.0;
-        errorPvFraction_ = 0.0;
+        // do not consider DOFs which are constraint. They are marked instead
+        // of looking up every DOF in the constraints map.
+        const unsigned numDof = currentResidual.size();
+        updateConstraintDofs_(numDof);
+
+        // calculate the error as the maximum weighted tolerance of the
+        // solution's residual. Each thread accumulates its own measures in
+        // local variables and stores them once at the end. The measures are
+        // packed as the maximum error, the pore volume, the pore volume where
+        // the CNV criterion is violated and the sum errors of the components.
+        enum { ErrorIdx, SumPvIdx, ErrorPvIdx, ComponentSumErrorIdx };
+        constexpr unsigned numMeasures = ComponentSumErrorIdx + numEq;
+#ifdef _OPENMP
+        const unsigned numThreads = omp_get_max_threads();
+#else
+        const unsigned numThreads = 1;
+#endif
+        std::vector<double> threadMeasures(numThreads*numMeasures, 0.0);
         const Scalar dt = this->simulator_.timeStepSize();
-        for (unsigned dofIdx = 0; dofIdx < currentResidual.size(); ++dofIdx) {
-            // do not consider auxiliary DOFs for the error
-            if (dofIdx >= this->model().numGridDof()
-                || this->model().dofTotalVolume(dofIdx) <= 0.0)
-                continue;
-
-            if (!this->model().isLocalDof(dofIdx))
-                continue;
-
-            // also do not consider DOFs which are constraint
-            if (this->enableConstraints_()) {
-                if (constraintsMap.count(dofIdx) > 0)
+        const Scalar tolerance = this->tolerance_;
+        const auto& model = this->model();
+        const auto& problem = this->simulator_.problem();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::array<double, numMeasures> measures;
+            measures.fill(0.0);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int dofIdx = 0; dofIdx < static_cast<int>(numDof); ++dofIdx) {
+                // do not consider auxiliary DOFs for the error
+                if (static_cast<unsigned>(dofIdx) >= model.numGridDof()
+                    || model.dofTotalVolume(dofIdx) <= 0.0)
                     continue;
-            }
 
-            const auto& r = currentResidual[dofIdx];
-            Scalar pvValue =
-                this->simulator_.problem().referencePorosity(dofIdx, /*timeIdx=*/0)
-                * this->model().dofTotalVolume(dofIdx);
-            sumPv += pvValue;
-            bool cnvViolated = false;
+                if (!model.isLocalDof(dofIdx) || constraintDofs_[dofIdx])
+                    continue;
 
-            Scalar dofVolume = this->model().dofTotalVolume(dofIdx);
+                const auto& r = currentResidual[dofIdx];
+                Scalar dofVolume = model.dofTotalVolume(dofIdx);
+                Scalar pvValue = problem.referencePorosity(dofIdx, /*timeIdx=*/0) * dofVolume;
+                measures[SumPvIdx] += pvValue;
+                bool cnvViolated = false;
 
-            for (unsigned eqIdx = 0; eqIdx < r.size(); ++eqIdx) {
-                Scalar tmpError = r[eqIdx] * dt * this->model().eqWeight(dofIdx, eqIdx) / pvValue;
-                Scalar tmpError2 = r[eqIdx] * this->model().eqWeight(dofIdx, eqIdx);
+                for (unsigned eqIdx = 0; eqIdx < r.size(); ++eqIdx) {
+                    Scalar tmpError = r[eqIdx] * dt * model.eqWeight(dofIdx, eqIdx) / pvValue;
+                    Scalar tmpError2 = r[eqIdx] * model.eqWeight(dofIdx, eqIdx);
 
-                // in the case of a volumetric formulation, the residual in the above is
-                // per cubic meter
-                if (GET_PROP_VALUE(TypeTag, UseVolumetricResidual)) {
-                    tmpError *= dofVolume;
-                    tmpError2 *= dofVolume;
-                }
+                    // in the case of a volumetric formulation, the residual in the above is
+                    // per cubic meter
+                    if (GET_PROP_VALUE(TypeTag, UseVolumetricResidual)) {
+                        tmpError *= dofVolume;
+                        tmpError2 *= dofVolume;
+                    }
 
-                this->error_ = Opm::max(std::abs(tmpError), this->error_);
+                    measures[ErrorIdx] = std::max<double>(std::abs(tmpError), measures[ErrorIdx]);
 
-                if (std::abs(tmpError) > this->tolerance_)
-                    cnvViolated = true;
+                    if (std::abs(tmpError) > tolerance)
+                        cnvViolated = true;
 
-                componentSumError[eqIdx] += std::abs(tmpError2);
+                    measures[ComponentSumErrorIdx + eqIdx] += std::abs(tmpError2);
+                }
+                if (cnvViolated)
+                    measures[ErrorPvIdx] += pvValue;
             }
-            if (cnvViolated)
-                errorPvFraction_ += pvValue;
-        }
 
-        // take the other processes into account
-        this->error_ = this->comm_.max(this->error_);
-        componentSumError = this->comm_.sum(componentSumError);
-        sumPv = this->comm_.sum(sumPv);
-        errorPvFraction_ = this->comm_.sum(errorPvFraction_);
+#ifdef _OPENMP
+            const unsigned threadIdx = omp_get_thread_num();
+#else
+            const unsigned threadIdx = 0;
+#endif
+            std::copy(measures.begin(), measures.end(), threadMeasures.begin() + threadIdx*numMeasures);
+        }
 
-        componentSumError /= sumPv;
-        componentSumError *= dt;
+        // combine the threads in a fixed order to get reproducible sums, then
+        // take the other processes into account by a single reduction
+        std::vector<double> measures(threadMeasures.begin(), threadMeasures.begin() + numMeasures);
+        for (unsigned threadIdx = 1; threadIdx < numThreads; ++threadIdx) {
+            const double* threadMeasure = threadMeasures.data() + threadIdx*numMeasures;
+            measures[ErrorIdx] = std::max(measures[ErrorIdx], threadMeasure[ErrorIdx]);
+            for (unsigned measureIdx = SumPvIdx; measureIdx < numMeasures; ++measureIdx)
+                measures[measureIdx] += threadMeasure[measureIdx];
+        }
+        reduceMaxAndSums(this->comm_, measures);
 
-        errorPvFraction_ /= sumPv;
+        this->error_ = measures[ErrorIdx];
+        const Scalar sumPv = measures[SumPvIdx];
+        errorPvFraction_ = measures[ErrorPvIdx] / sumPv;
 
         errorSum_ = 0;
-        for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
-            errorSum_ = std::max(std::abs(componentSumError[eqIdx]), errorSum_);
+        for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+            const Scalar componentSumError = measures[ComponentSumErrorIdx + eqIdx] / sumPv * dt;
+            errorSum_ = std::max(std::abs(componentSumError), errorSum_);
+        }
 
         // scale the tolerance for the total error with the pore volume. by default, the
         // exponent is 1/3, i.e., cubic root.
@@ -240,6 +304,26 @@ public:
     }
 
 private:
+    // mark the constrained DOFs. The marks are only rebuilt if the constrained
+    // DOFs differ from the ones of the last call.
+    void updateConstraintDofs_(unsigned numDof)
+    {
+        std::vector<unsigned> constrainedDofs;
+        if (this->enableConstraints_()) {
+            for (const auto& constraint : this->model().linearizer().constraintsMap()) {
+                if (constraint.first < numDof)
+                    constrainedDofs.push_back(constraint.first);
+            }
+        }
+        if (constraintDofs_.size() == numDof && constrainedDofs == constrainedDofs_)
+            return;
+
+        constraintDofs_.assign(numDof, 0);
+        for (const unsigned dofIdx : constrainedDofs)
+            constraintDofs_[dofIdx] = 1;
+        constrainedDofs_ = std::move(constrainedDofs);
+    }
+
     Scalar errorPvFraction_;
     Scalar errorSum_;
 
@@ -249,6 +333,9 @@ private:
     Scalar sumTolerance_;
 
     int numStrictIterations_;
+
+    std::vector<char> constraintDofs_;
+    std::vector<unsigned> constrainedDofs_;
 };
 } // namespace Opm
 
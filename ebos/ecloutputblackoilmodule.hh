@@ -39,9 +39,12 @@
 #include <opm/output/data/Cells.hpp>
 #include <opm/output/eclipse/EclipseIO.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
+#include <opm/simulators/utils/RegionAggregator.hpp>
 
 #include <dune/common/fvector.hh>
 
+#include <numeric>
 #include <type_traits>
 
 BEGIN_PROPERTIES
@@ -239,7 +242,7 @@ public:
                 computeFip_ = true;
             }
             else
-                fip_[i].clear();
+                releaseBuffer_(fip_[i]);
         }
         if (!substep || summaryConfig.hasKeyword("FPR") || summaryConfig.hasKeyword("FPRP") || summaryConfig.hasKeyword("RPR")) {
             fip_[FipDataType::PoreVolume].resize(bufferSize, 0.0);
@@ -248,9 +251,9 @@ public:
             pressureTimesHydrocarbonVolume_.resize(bufferSize, 0.0);
         }
         else {
-            hydrocarbonPoreVolume_.clear();
-            pressureTimesPoreVolume_.clear();
-            pressureTimesHydrocarbonVolume_.clear();
+            releaseBuffer_(hydrocarbonPoreVolume_);
+            releaseBuffer_(pressureTimesPoreVolume_);
+            releaseBuffer_(pressureTimesHydrocarbonVolume_);
         }
 
         // Well RFT data
@@ -288,8 +291,12 @@ public:
         // 1) when we want to restart
         // 2) when it is ask for by the user via restartConfig
         // 3) when it is not a substep
-        if (!isRestart && (!restartConfig.getWriteRestartFile(reportStepNum, log) || substep))
+        // otherwise the buffers of the last step which wrote them are freed, they
+        // would only be filled without being written
+        if (!isRestart && (!restartConfig.getWriteRestartFile(reportStepNum, log) || substep)) {
+            releaseFieldBuffers_();
             return;
+        }
 
         // always output saturation of active phases
         for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx) {
@@ -438,6 +445,37 @@ public:
 
     }
 
+    /*!
+     * \brief Returns the number of bytes held by the output buffers.
+     */
+    std::size_t memoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (const ScalarBuffer* buffer : fieldBuffers_())
+            bytes += Opm::memoryUsageOf(*buffer);
+        for (const auto& buffer : tracerConcentrations_)
+            bytes += Opm::memoryUsageOf(buffer);
+        for (const auto& buffer : fip_)
+            bytes += Opm::memoryUsageOf(buffer);
+        for (const auto& buffer : origRegionValues_)
+            bytes += Opm::memoryUsageOf(buffer);
+
+        return bytes
+            + Opm::memoryUsageOf(temperature_)
+            + Opm::memoryUsageOf(failedCellsPb_)
+            + Opm::memoryUsageOf(failedCellsPd_)
+            + Opm::memoryUsageOf(fipnum_)
+            + fipRegions_.memoryUsage()
+            + Opm::memoryUsageOf(origTotalValues_)
+            + Opm::memoryUsageOf(hydrocarbonPoreVolume_)
+            + Opm::memoryUsageOf(pressureTimesPoreVolume_)
+            + Opm::memoryUsageOf(pressureTimesHydrocarbonVolume_)
+            + Opm::memoryUsageOf(blockData_)
+            + Opm::memoryUsageOf(oilConnectionPressures_)
+            + Opm::memoryUsageOf(waterConnectionSaturations_)
+            + Opm::memoryUsageOf(gasConnectionSaturations_);
+    }
+
     /*!
      * \brief Modify the internal buffers according to the intensive quanties relevant
      *        for an element
@@ -1017,39 +1055,37 @@ public:
     // write Fluid In Place to output log
     void outputFipLog(std::map<std::string, double>& miscSummaryData,  std::map<std::string, std::vector<double>>& regionData, const bool substep)
     {
-        const auto& comm = simulator_.gridView().comm();
-        auto maxElement = std::max_element(fipnum_.begin(), fipnum_.end());
-        size_t ntFip = 0;
-        if ( maxElement != fipnum_.end() ) {
-            ntFip = *maxElement;
-        }
-        ntFip = comm.max(ntFip);
+        // sum values over each region. all quantities are summed in a single
+        // pass over the cells and communicated at once.
+        std::vector<const ScalarBuffer*> cellValues;
+        for (int i = 0; i < FipDataType::numFipValues; i++)
+            cellValues.push_back(&fip_[i]);
+        cellValues.push_back(&pressureTimesPoreVolume_);
+        cellValues.push_back(&hydrocarbonPoreVolume_);
+        cellValues.push_back(&pressureTimesHydrocarbonVolume_);
+        fipRegions_.sum(cellValues, simulator_.gridView().comm());
+        const size_t ntFip = fipRegions_.numRegions();
 
-        // sum values over each region
         ScalarBuffer regionFipValues[FipDataType::numFipValues];
         for (int i = 0; i < FipDataType::numFipValues; i++) {
-            regionFipValues[i] = computeFipForRegions_(fip_[i], fipnum_, ntFip);
+            regionFipValues[i] = fipRegions_.totals(i);
             if (isIORank_() && origRegionValues_[i].empty())
                 origRegionValues_[i] = regionFipValues[i];
         }
 
         // sum all region values to compute the field total
-        std::vector<int> fieldNum(ntFip, 1);
         ScalarBuffer fieldFipValues(FipDataType::numFipValues, 0.0);
-        bool comunicateSum = false; // the regionValues are already summed over all ranks.
-        for (int i = 0; i<FipDataType::numFipValues; i++) {
-            const ScalarBuffer& tmp = computeFipForRegions_(regionFipValues[i], fieldNum, 1, comunicateSum);
-            fieldFipValues[i] = tmp[0];
-        }
+        for (int i = 0; i<FipDataType::numFipValues; i++)
+            fieldFipValues[i] = std::accumulate(regionFipValues[i].begin(), regionFipValues[i].end(), 0.0);
 
         // compute the hydrocarbon averaged pressure over the regions.
-        ScalarBuffer regPressurePv = computeFipForRegions_(pressureTimesPoreVolume_, fipnum_, ntFip);
-        ScalarBuffer regPvHydrocarbon = computeFipForRegions_(hydrocarbonPoreVolume_, fipnum_, ntFip);
-        ScalarBuffer regPressurePvHydrocarbon = computeFipForRegions_(pressureTimesHydrocarbonVolume_, fipnum_, ntFip);
+        ScalarBuffer regPressurePv = fipRegions_.totals(FipDataType::numFipValues);
+        ScalarBuffer regPvHydrocarbon = fipRegions_.totals(FipDataType::numFipValues + 1);
+        ScalarBuffer regPressurePvHydrocarbon = fipRegions_.totals(FipDataType::numFipValues + 2);
 
-        ScalarBuffer fieldPressurePv = computeFipForRegions_(regPressurePv, fieldNum, 1, comunicateSum);
-        ScalarBuffer fieldPvHydrocarbon = computeFipForRegions_(regPvHydrocarbon, fieldNum, 1, comunicateSum);
-        ScalarBuffer fieldPressurePvHydrocarbon = computeFipForRegions_(regPressurePvHydrocarbon, fieldNum, 1, comunicateSum);
+        ScalarBuffer fieldPressurePv(1, std::accumulate(regPressurePv.begin(), regPressurePv.end(), 0.0));
+        ScalarBuffer fieldPvHydrocarbon(1, std::accumulate(regPvHydrocarbon.begin(), regPvHydrocarbon.end(), 0.0));
+        ScalarBuffer fieldPressurePvHydrocarbon(1, std::accumulate(regPressurePvHydrocarbon.begin(), regPressurePvHydrocarbon.end(), 0.0));
 
         // output on io rank
         // the original Fip values are stored on the first step
@@ -1742,6 +1778,43 @@ private:
 
     }
 
+    static void releaseBuffer_(ScalarBuffer& buffer)
+    { ScalarBuffer().swap(buffer); }
+
+    // the buffers which are only allocated for the steps which write restart files
+    std::vector<ScalarBuffer*> fieldBuffers_()
+    {
+        std::vector<ScalarBuffer*> buffers = {
+            &oilPressure_, &gasDissolutionFactor_, &oilVaporizationFactor_,
+            &gasFormationVolumeFactor_, &saturatedOilFormationVolumeFactor_,
+            &oilSaturationPressure_, &rs_, &rv_, &sSol_, &cPolymer_, &cFoam_, &cSalt_,
+            &soMax_, &pcSwMdcOw_, &krnSwMdcOw_, &pcSwMdcGo_, &krnSwMdcGo_, &ppcw_,
+            &bubblePointPressure_, &dewPointPressure_, &rockCompPorvMultiplier_,
+            &rockCompTransMultiplier_, &swMax_, &overburdenPressure_, &minimumOilPressure_
+        };
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            buffers.push_back(&saturation_[phaseIdx]);
+            buffers.push_back(&invB_[phaseIdx]);
+            buffers.push_back(&density_[phaseIdx]);
+            buffers.push_back(&viscosity_[phaseIdx]);
+            buffers.push_back(&relativePermeability_[phaseIdx]);
+        }
+        return buffers;
+    }
+
+    std::vector<const ScalarBuffer*> fieldBuffers_() const
+    {
+        const auto buffers = const_cast<EclOutputBlackOilModule*>(this)->fieldBuffers_();
+        return std::vector<const ScalarBuffer*>(buffers.begin(), buffers.end());
+    }
+
+    void releaseFieldBuffers_()
+    {
+        for (ScalarBuffer* buffer : fieldBuffers_())
+            releaseBuffer_(*buffer);
+        std::vector<ScalarBuffer>().swap(tracerConcentrations_);
+    }
+
     void createLocalFipnum_()
     {
         const auto& gridView = simulator_.vanguard().gridView();
@@ -1759,33 +1832,13 @@ private:
             if (elem.partitionType() != Dune::InteriorEntity)
                 fipnum_[elemIdx] = 0;
         }
-    }
-
-    // Sum Fip values over regions.
-    ScalarBuffer computeFipForRegions_(const ScalarBuffer& fip, std::vector<int>& regionId, size_t maxNumberOfRegions, bool commSum = true)
-    {
-        ScalarBuffer totals(maxNumberOfRegions, 0.0);
-
-        if (fip.empty())
-            return totals;
-
-        assert(regionId.size() == fip.size());
-        for (size_t j = 0; j < regionId.size(); ++j) {
-            const int regionIdx = regionId[j] - 1;
-            // the cell is not attributed to any region. ignore it!
-            if (regionIdx < 0)
-                continue;
-
-            assert(regionIdx < static_cast<int>(maxNumberOfRegions));
-            totals[regionIdx] += fip[j];
-        }
-        if (commSum) {
-            const auto& comm = simulator_.gridView().comm();
-            for (size_t i = 0; i < maxNumberOfRegions; ++i)
-                totals[i] = comm.sum(totals[i]);
-        }
 
-        return totals;
+        // the FIPNUM regions are one-based, zero marks the cells which are not
+        // summed
+        std::vector<int> cellRegion(fipnum_.size());
+        std::transform(fipnum_.begin(), fipnum_.end(), cellRegion.begin(),
+                       [](int fipnum) { return fipnum - 1; });
+        fipRegions_ = Opm::RegionAggregator(cellRegion, simulator_.gridView().comm());
     }
 
     ScalarBuffer pressureAverage_(const ScalarBuffer& pressurePvHydrocarbon, const ScalarBuffer& pvHydrocarbon, const ScalarBuffer& pressurePv, const ScalarBuffer& pv, bool hydrocarbon)
@@ -2135,6 +2188,7 @@ private:
     std::vector<int> failedCellsPb_;
     std::vector<int> failedCellsPd_;
     std::vector<int> fipnum_;
+    Opm::RegionAggregator fipRegions_;
     ScalarBuffer fip_[FipDataType::numFipValues];
     ScalarBuffer origTotalValues_;
     ScalarBuffer origRegionValues_[FipDataType::numFipValues];
@@ -31,6 +31,7 @@
 #include "ecltransmissibility.hh"
 
 #include <opm/grid/polyhedralgrid.hh>
+#include <opm/simulators/utils/MemoryReport.hpp>
 
 namespace Opm {
 template <class TypeTag>
@@ -167,6 +168,24 @@ public:
         return simulator_.problem().eclTransmissibilities();
     }
 
+    /*!
+     * \brief Adds the memory used by the grid, estimated from the numbers of its
+     *        cells, faces and vertices.
+     *
+     * The global transmissibilities are the ones of the problem, so they are not
+     * counted here.
+     */
+    void addMemoryUsage(MemoryReport& report) const
+    {
+        const std::size_t numCells = grid_->size(/*codim=*/0);
+        const std::size_t numFaces = grid_->size(/*codim=*/1);
+        const std::size_t numVertices = grid_->size(Grid::dimension);
+        report.add("Grid", numCells*(4*sizeof(double) + 13*sizeof(int))
+                   + numFaces*(7*sizeof(double) + 7*sizeof(int))
+                   + numVertices*3*sizeof(double));
+        report.add("Transmissibilities", 0);
+    }
+
 protected:
     void createGrids_()
     {
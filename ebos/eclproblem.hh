@@ -102,6 +102,7 @@
 #include <opm/output/eclipse/EclipseIO.hpp>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 
 #include <boost/date_time.hpp>
 
@@ -314,6 +315,15 @@ SET_BOOL_PROP(EclBaseProblem, EnableAsyncEclOutput, true);
 // By default, use single precision for the ECL formated results
 SET_BOOL_PROP(EclBaseProblem, EclOutputDoublePrecision, false);
 
+// Per-process checkpoint files are not written by default. If enabled, they
+// are written at every report step and only the latest one is kept
+SET_BOOL_PROP(EclBaseProblem, EnablePerRankCheckpoint, false);
+SET_INT_PROP(EclBaseProblem, PerRankCheckpointInterval, 1);
+
+// Allow two report steps to wait for the ECL output thread, without a memory limit
+SET_INT_PROP(EclBaseProblem, EclOutputQueueDepth, 2);
+SET_SCALAR_PROP(EclBaseProblem, EclOutputQueueMemoryLimit, 0.0);
+
 // The default location for the ECL output files
 SET_STRING_PROP(EclBaseProblem, OutputDir, ".");
 
@@ -702,6 +712,12 @@ public:
         else
             readInitialCondition_();
 
+        // the temperature is kept separately because the initial fluid states are
+        // released after the first report step
+        initialTemperature_.resize(numDof);
+        for (size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+            initialTemperature_[dofIdx] = initialFluidStates_[dofIdx].temperature(/*phaseIdx=*/0);
+
         updatePffDofData_();
 
         if (GET_PROP_VALUE(TypeTag, EnablePolymer)) {
@@ -728,6 +744,7 @@ public:
             eclWriter_->writeInit();
 
         simulator.vanguard().releaseGlobalTransmissibilities();
+        simulator.vanguard().releaseEquilGrid();
 
         // after finishing the initialization and writing the initial solution, we move
         // to the first "real" episode/report step
@@ -811,6 +828,10 @@ public:
             updatePffDofData_();
         }
 
+        // the initial report step has been written at this point
+        if (episodeIdx >= 0)
+            releaseInitialFluidStates_();
+
         if (enableExperiments && this->gridView().comm().rank() == 0 && episodeIdx >= 0) {
             // print some useful information in experimental mode. (the production
             // simulator does this externally.)
@@ -1179,6 +1200,40 @@ public:
     const EclTransmissibility<TypeTag>& eclTransmissibilities() const
     { return transmissibilities_; }
 
+    /*!
+     * \brief Adds the memory used by the grid, the transmissibilities, the per-cell
+     *        properties of the problem and the output buffers.
+     *
+     * The parameters of the material laws are not accounted for.
+     */
+    void addMemoryUsage(MemoryReport& report) const
+    {
+        this->simulator().vanguard().addMemoryUsage(report);
+        report.add("Transmissibilities", transmissibilities_.memoryUsage());
+
+        std::size_t fieldBytes =
+            Opm::memoryUsageOf(referencePorosity_[0]) + Opm::memoryUsageOf(referencePorosity_[1])
+            + Opm::memoryUsageOf(elementCenterDepth_) + Opm::memoryUsageOf(initialTemperature_)
+            + Opm::memoryUsageOf(pvtnum_) + Opm::memoryUsageOf(satnum_)
+            + Opm::memoryUsageOf(miscnum_) + Opm::memoryUsageOf(plmixnum_)
+            + Opm::memoryUsageOf(rockTableIdx_) + Opm::memoryUsageOf(rockParams_)
+            + Opm::memoryUsageOf(maxPolymerAdsorption_) + Opm::memoryUsageOf(polymerConcentration_)
+            + Opm::memoryUsageOf(polymerMoleWeight_) + Opm::memoryUsageOf(solventSaturation_)
+            + Opm::memoryUsageOf(dRsDtOnlyFreeGas_) + Opm::memoryUsageOf(lastRs_)
+            + Opm::memoryUsageOf(maxDRs_) + Opm::memoryUsageOf(lastRv_) + Opm::memoryUsageOf(maxDRv_)
+            + Opm::memoryUsageOf(maxOilSaturation_) + Opm::memoryUsageOf(maxWaterSaturation_)
+            + Opm::memoryUsageOf(overburdenPressure_) + Opm::memoryUsageOf(minOilPressure_)
+            + drift_.size()*sizeof(typename GlobalEqVector::block_type);
+        for (const auto* freebc : {&freebcX_, &freebcXMinus_, &freebcY_, &freebcYMinus_, &freebcZ_, &freebcZMinus_})
+            fieldBytes += Opm::memoryUsageOf(*freebc);
+        for (const auto* massratebc : {&massratebcX_, &massratebcXMinus_, &massratebcY_,
+                                       &massratebcYMinus_, &massratebcZ_, &massratebcZMinus_})
+            fieldBytes += Opm::memoryUsageOf(*massratebc);
+        report.add("Field properties", fieldBytes);
+        report.add("Initial fluid states", Opm::memoryUsageOf(initialFluidStates_));
+        report.add("Output buffers", eclWriter_ ? eclWriter_->eclOutputModule().memoryUsage() : 0);
+    }
+
     /*!
      * \copydoc BlackOilBaseProblem::thresholdPressure
      */
@@ -1220,6 +1275,29 @@ public:
     Scalar referencePorosity(unsigned elementIdx, unsigned timeIdx) const
     { return referencePorosity_[timeIdx][elementIdx]; }
 
+    /*!
+     * \brief Returns the reference porosities of all elements
+     */
+    const std::vector<Scalar>& referencePorosity(unsigned timeIdx) const
+    { return referencePorosity_[timeIdx]; }
+
+    /*!
+     * \brief Overwrite the reference porosity of all elements
+     *
+     * This is intended to be called between time steps, e.g. by the Python
+     * bindings. As for the porosity modifiers of the SCHEDULE section, the
+     * storage term of the previous time level keeps using the old porosity.
+     */
+    void setReferencePorosity(const Scalar* porosity, std::size_t numElements)
+    {
+        if (numElements != referencePorosity_[0].size())
+            throw std::runtime_error("The number of porosity values must match the number of elements");
+
+        referencePorosity_[1] = referencePorosity_[0];
+        std::copy(porosity, porosity + numElements, referencePorosity_[0].begin());
+        this->model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+    }
+
 
     /*!
      * \brief Returns the depth of an degree of freedom [m]
@@ -1465,7 +1543,7 @@ public:
         // use the initial temperature of the DOF if temperature is not a primary
         // variable
         unsigned globalDofIdx = context.globalSpaceIndex(spaceIdx, timeIdx);
-        return initialFluidStates_[globalDofIdx].temperature(/*phaseIdx=*/0);
+        return initialTemperature_[globalDofIdx];
     }
 
     /*!
@@ -1769,7 +1847,9 @@ public:
     EclAquiferModel& mutableAquiferModel()
     { return aquiferModel_; }
 
-    // temporary solution to facilitate output of initial state from flow
+    // temporary solution to facilitate output of initial state from flow. unless
+    // they are needed for the boundary conditions or rock compaction, the initial
+    // fluid states are released when the first report step begins.
     const InitialFluidState& initialFluidState(unsigned globalDofIdx) const
     { return initialFluidStates_[globalDofIdx]; }
 
@@ -2376,6 +2456,21 @@ private:
         FluidSystem::initFromState(eclState, schedule);
    }
 
+    // the full initial fluid states are only needed for the boundary conditions,
+    // the water induced rock compaction and the output of the initial report step
+    void releaseInitialFluidStates_()
+    {
+        if (initialFluidStates_.empty())
+            return;
+
+        const bool thermalBoundaries = enableEnergy && enableThermalFluxBoundaries;
+        if (thermalBoundaries || nonTrivialBoundaryConditions_
+            || !rockCompPoroMult_.empty() || !rockCompTransMult_.empty())
+            return;
+
+        std::vector<InitialFluidState>().swap(initialFluidStates_);
+    }
+
     void readInitialCondition_()
     {
         const auto& simulator = this->simulator();
@@ -3055,6 +3150,7 @@ private:
     std::vector<Scalar> maxPolymerAdsorption_;
 
     std::vector<InitialFluidState> initialFluidStates_;
+    std::vector<Scalar> initialTemperature_;
 
     std::vector<Scalar> polymerConcentration_;
     // polymer molecular weight
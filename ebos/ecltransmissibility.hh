@@ -30,6 +30,8 @@
 
 #include <ebos/nncsorter.hpp>
 
+#include <opm/simulators/utils/MemoryReport.hpp>
+
 #include <opm/models/utils/propertysystem.hh>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -414,6 +416,21 @@ public:
         removeSmallNonCartesianTransmissibilities_();
     }
 
+    /*!
+     * \brief Returns the number of bytes held by the transmissibilities and the
+     *        permeabilities.
+     */
+    std::size_t memoryUsage() const
+    {
+        std::size_t bytes = Opm::memoryUsageOf(permeability_)
+            + Opm::memoryUsageOf(trans_)
+            + Opm::memoryUsageOf(transBoundary_)
+            + Opm::memoryUsageOf(thermalHalfTransBoundary_);
+        if (enableEnergy)
+            bytes += Opm::memoryUsageOf(*thermalHalfTrans_);
+        return bytes;
+    }
+
     /*!
      * \brief Return the permeability for an element.
      */
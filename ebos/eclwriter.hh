@@ -48,6 +48,9 @@
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
+#if HAVE_MPI
+#include <opm/simulators/utils/RankCheckpoint.hpp>
+#endif
 #include <opm/grid/GridHelpers.hpp>
 #include <opm/grid/utility/cartesianToCompressed.hpp>
 
@@ -55,11 +58,23 @@
 #include <opm/material/common/Exceptions.hpp>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/FileSystem.hpp>
+
+#include <dune/grid/common/mcmgmapper.hh>
 
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <utility>
 #include <string>
 #include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
 
 #ifdef HAVE_MPI
 #include <mpi.h>
@@ -70,6 +85,10 @@ BEGIN_PROPERTIES
 NEW_PROP_TAG(EnableEclOutput);
 NEW_PROP_TAG(EnableAsyncEclOutput);
 NEW_PROP_TAG(EclOutputDoublePrecision);
+NEW_PROP_TAG(EnablePerRankCheckpoint);
+NEW_PROP_TAG(PerRankCheckpointInterval);
+NEW_PROP_TAG(EclOutputQueueDepth);
+NEW_PROP_TAG(EclOutputQueueMemoryLimit);
 
 END_PROPERTIES
 
@@ -174,6 +193,15 @@ public:
 
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableAsyncEclOutput,
                              "Write the ECL-formated results in a non-blocking way (i.e., using a separate thread).");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputQueueDepth,
+                             "The maximum number of report steps which may be waiting to be written by the ECL output thread.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, EclOutputQueueMemoryLimit,
+                             "The maximum memory in MB held by the ECL output requests waiting to be written, 0 means no limit.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnablePerRankCheckpoint,
+                             "Let each process write its part of the restart data to a separate file. Only the latest checkpoint is kept. "
+                             "The ECL restart solution is then only gathered on the I/O rank at the report steps which write a restart file.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, PerRankCheckpointInterval,
+                             "The number of report steps between two per-process checkpoints.");
     }
 
     // The Simulator object should preferably have been const - the
@@ -198,10 +226,17 @@ public:
         if (enableAsyncOutput && collectToIORank_.isIORank())
             numWorkerThreads = 1;
         taskletRunner_.reset(new TaskletRunner(numWorkerThreads));
+        outputQueue_ = std::make_shared<OutputQueue>(EWOMS_GET_PARAM(TypeTag, int, EclOutputQueueDepth),
+                                                     EWOMS_GET_PARAM(TypeTag, Scalar, EclOutputQueueMemoryLimit) * 1024 * 1024);
     }
 
     ~EclWriter()
-    { }
+    {
+        // write all pending output before the queue is reported
+        taskletRunner_->barrier();
+        if (collectToIORank_.isIORank())
+            OpmLog::info(outputQueue_->report());
+    }
 
     const Opm::EclipseIO& eclIO() const
     {
@@ -352,7 +387,11 @@ public:
         const auto& gridView = simulator_.vanguard().gridView();
         int numElements = gridView.size(/*codim=*/0);
         bool log = collectToIORank_.isIORank();
-        eclOutputModule_.allocBuffers(numElements, reportStepNum, isSubStep, log, /*isRestart*/ false);
+        // the checkpoint needs all restart fields, also at the report
+        // steps which do not write an ECL restart file.
+        const bool writeCheckpoint = !isSubStep && enablePerRankCheckpoint_()
+            && reportStepNum % std::max(EWOMS_GET_PARAM(TypeTag, int, PerRankCheckpointInterval), 1) == 0;
+        eclOutputModule_.allocBuffers(numElements, reportStepNum, isSubStep, log, /*isRestart*/ writeCheckpoint);
 
         ElementContext elemCtx(simulator_);
         ElementIterator elemIt = gridView.template begin</*codim=*/0>();
@@ -370,12 +409,22 @@ public:
         if (!isSubStep)
             eclOutputModule_.assignToSolution(localCellData);
 
+        if (writeCheckpoint)
+            writeRankCheckpoint_(reportStepNum, localCellData, localWellData, nextStepSize);
+
         // add cell data to perforations for Rft output
         if (!isSubStep)
             eclOutputModule_.addRftDataToWells(localWellData, reportStepNum);
 
-        if (collectToIORank_.isParallel())
-            collectToIORank_.collect(localCellData, eclOutputModule_.getBlockData(), localWellData, localGroupData);
+        if (collectToIORank_.isParallel()) {
+            // with per-process checkpoints the solution is only needed on
+            // the I/O rank if an ECL restart file is written at this step.
+            const bool collectCellData = !writeCheckpoint
+                || schedule().restart().getWriteRestartFile(reportStepNum, /*log=*/false);
+            const Opm::data::Solution noCellData;
+            collectToIORank_.collect(collectCellData ? localCellData : noCellData,
+                                     eclOutputModule_.getBlockData(), localWellData, localGroupData);
+        }
 
 
         if (collectToIORank_.isIORank()) {
@@ -383,9 +432,15 @@ public:
             const auto& simConfig = eclState.getSimulationConfig();
 
             bool enableDoublePrecisionOutput = EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision);
-            const Opm::data::Solution& cellData = collectToIORank_.isParallel() ? collectToIORank_.globalCellData() : localCellData;
-            const Opm::data::Wells& wellData = collectToIORank_.isParallel() ? collectToIORank_.globalWellData() : localWellData;
-            Opm::RestartValue restartValue(cellData, wellData);
+            // the cell data is not needed after this point, so it is moved
+            // into the tasklet instead of copying all cell arrays.
+            Opm::data::Solution& cellData = collectToIORank_.isParallel() ? collectToIORank_.globalCellData() : localCellData;
+            Opm::data::Wells wellData;
+            if (collectToIORank_.isParallel())
+                wellData = collectToIORank_.globalWellData();
+            else
+                wellData = std::move(localWellData);
+            Opm::RestartValue restartValue(std::move(cellData), std::move(wellData));
 
             if (simConfig.useThresholdPressure())
                 restartValue.addExtra("THRESHPR", Opm::UnitSystem::measure::pressure, simulator_.problem().thresholdPressure().data());
@@ -394,18 +449,24 @@ public:
             if (!isSubStep)
                 restartValue.addExtra("OPMEXTRA", std::vector<double>(1, nextStepSize));
 
+            const std::size_t restartValueSize = EclWriteTasklet::memorySize(restartValue);
+
             // first, create a tasklet to write the data for the current time step to disk
             auto eclWriteTasklet = std::make_shared<EclWriteTasklet>(summaryState(),
                                                                      *eclIO_,
                                                                      reportStepNum,
                                                                      isSubStep,
                                                                      curTime,
-                                                                     restartValue,
-                                                                     enableDoublePrecisionOutput);
+                                                                     std::move(restartValue),
+                                                                     enableDoublePrecisionOutput,
+                                                                     outputQueue_,
+                                                                     restartValueSize);
 
-            // then, make sure that the previous I/O request has been completed and the
-            // number of incomplete tasklets does not increase between time steps
-            taskletRunner_->barrier();
+            // then, wait until the queue has room for the new request. The
+            // number of incomplete tasklets and the memory they hold is
+            // bounded, but a burst of report steps does not stall the
+            // simulator as long as the queue is not full.
+            outputQueue_->waitForSlot(restartValueSize);
 
             // finally, start a new output writing job
             taskletRunner_->dispatch(eclWriteTasklet);
@@ -449,11 +510,16 @@ public:
 
         {
             Opm::SummaryState& summaryState = simulator_.vanguard().summaryState();
-            auto restartValues = loadParallelRestart(eclIO_.get(), summaryState, solutionKeys, extraKeys,
-                                                     gridView.grid().comm());
+            Opm::data::Solution sol;
+            Opm::data::Wells wells;
+            Opm::RestartValue restartValues(sol, wells);
+            bool localSolution = false;
+            if (!(enablePerRankCheckpoint_() && loadRankCheckpoint_(restartStepIdx, restartValues, localSolution)))
+                restartValues = loadParallelRestart(eclIO_.get(), summaryState, solutionKeys, extraKeys,
+                                                    gridView.grid().comm());
 
             for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
-                unsigned globalIdx = collectToIORank_.localIdxToGlobalIdx(elemIdx);
+                unsigned globalIdx = localSolution ? elemIdx : collectToIORank_.localIdxToGlobalIdx(elemIdx);
                 eclOutputModule_.setRestart(restartValues.solution, elemIdx, globalIdx);
             }
 
@@ -487,6 +553,165 @@ private:
     static bool enableEclOutput_()
     { return EWOMS_GET_PARAM(TypeTag, bool, EnableEclOutput); }
 
+    static bool enablePerRankCheckpoint_()
+    {
+#if HAVE_MPI
+        return EWOMS_GET_PARAM(TypeTag, bool, EnablePerRankCheckpoint);
+#else
+        return false;
+#endif
+    }
+
+    std::string checkpointCaseName_() const
+    {
+        const auto& ioConfig = eclState().getIOConfig();
+        return (Opm::filesystem::path(ioConfig.getOutputDir()) / ioConfig.getBaseName()).string();
+    }
+
+    std::string restartCheckpointCaseName_() const
+    {
+        const auto& ioConfig = eclState().getIOConfig();
+        Opm::filesystem::path restartRoot(eclState().getInitConfig().getRestartRootName());
+        if (restartRoot.is_relative())
+            restartRoot = Opm::filesystem::path(ioConfig.getOutputDir()) / restartRoot;
+        return restartRoot.string();
+    }
+
+    // Write the restart data of this process, the solution is indexed by
+    // the local cells and the global index of each cell is stored with it.
+    // The previous checkpoint of this run is removed once all processes have
+    // written the new one.
+    void writeRankCheckpoint_(int reportStepNum,
+                              const Opm::data::Solution& localCellData,
+                              const Opm::data::Wells& localWellData,
+                              Scalar nextStepSize)
+    {
+#if HAVE_MPI
+        const auto& gridView = simulator_.vanguard().gridView();
+        const auto& comm = gridView.comm();
+
+        Opm::RankCheckpoint checkpoint;
+        checkpoint.reportStep = reportStepNum;
+        checkpoint.rank = comm.rank();
+        checkpoint.numRanks = comm.size();
+        checkpoint.globalIndex.resize(gridView.size(/*codim=*/0));
+        checkpoint.interior.resize(gridView.size(/*codim=*/0));
+        Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elemMapper(gridView, Dune::mcmgElementLayout());
+        ElementIterator elemIt = gridView.template begin</*codim=*/0>();
+        const ElementIterator& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const unsigned elemIdx = elemMapper.index(*elemIt);
+            checkpoint.globalIndex[elemIdx] = collectToIORank_.localIdxToGlobalIdx(elemIdx);
+            checkpoint.interior[elemIdx] = elemIt->partitionType() == Dune::InteriorEntity;
+        }
+
+        checkpoint.restartValue = Opm::RestartValue(localCellData, localWellData);
+        if (eclState().getSimulationConfig().useThresholdPressure())
+            checkpoint.restartValue.addExtra("THRESHPR", Opm::UnitSystem::measure::pressure,
+                                             simulator_.problem().thresholdPressure().data());
+        checkpoint.restartValue.addExtra("OPMEXTRA", std::vector<double>(1, nextStepSize));
+        checkpoint.summaryState = summaryState().serialize();
+
+        const std::string caseName = checkpointCaseName_();
+        std::exception_ptr exception;
+        try {
+            Opm::writeRankCheckpoint(Opm::rankCheckpointFileName(caseName, reportStepNum, comm.rank()),
+                                     checkpoint);
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+
+        // the old checkpoints are only useful if not all new ones are written
+        if (!comm.min(static_cast<int>(!exception))) {
+            if (exception)
+                std::rethrow_exception(exception);
+            throw std::runtime_error("Writing the checkpoint of report step " + std::to_string(reportStepNum)
+                                     + " failed on another process");
+        }
+
+        if (lastRankCheckpointStep_ >= 0 && lastRankCheckpointStep_ != reportStepNum) {
+            std::error_code ec;
+            Opm::filesystem::remove(Opm::rankCheckpointFileName(caseName, lastRankCheckpointStep_, comm.rank()), ec);
+            if (ec)
+                OpmLog::warning("Could not remove the checkpoint of report step "
+                                + std::to_string(lastRankCheckpointStep_) + ": " + ec.message());
+        }
+        lastRankCheckpointStep_ = reportStepNum;
+#else
+        (void) reportStepNum;
+        (void) localCellData;
+        (void) localWellData;
+        (void) nextStepSize;
+#endif
+    }
+
+    // Load the restart data from the per-process checkpoints. If all
+    // processes find a checkpoint of the same partition, each of them uses
+    // its own file and localSolution is set. Otherwise the checkpoints are
+    // merged on the I/O rank and distributed like an ECL restart file.
+    bool loadRankCheckpoint_(int restartStepIdx, Opm::RestartValue& restartValues, bool& localSolution)
+    {
+        localSolution = false;
+#if HAVE_MPI
+        const auto& gridView = simulator_.vanguard().gridView();
+        const auto& comm = gridView.comm();
+        const std::string caseName = restartCheckpointCaseName_();
+
+        Opm::RankCheckpoint checkpoint;
+        bool samePartition =
+            Opm::readRankCheckpoint(Opm::rankCheckpointFileName(caseName, restartStepIdx, comm.rank()), checkpoint)
+            && checkpoint.numRanks == comm.size()
+            && checkpoint.globalIndex.size() == static_cast<std::size_t>(gridView.size(/*codim=*/0));
+        for (std::size_t elemIdx = 0; samePartition && elemIdx < checkpoint.globalIndex.size(); ++elemIdx)
+            samePartition = checkpoint.globalIndex[elemIdx] == collectToIORank_.localIdxToGlobalIdx(elemIdx);
+
+        if (comm.min(static_cast<int>(samePartition))) {
+            OpmLog::info("Restarting from the per-process checkpoint files of report step "
+                         + std::to_string(restartStepIdx));
+            restartValues = std::move(checkpoint.restartValue);
+            summaryState().deserialize(checkpoint.summaryState);
+            localSolution = true;
+            return true;
+        }
+
+        Opm::RankCheckpoint merged;
+        int haveMerged = 0;
+        if (collectToIORank_.isIORank())
+            haveMerged = Opm::mergeRankCheckpoints(caseName, restartStepIdx,
+                                                   globalGrid().leafGridView().size(/*codim=*/0), merged);
+        comm.broadcast(&haveMerged, 1, collectToIORank_.ioRank);
+        if (!haveMerged)
+            return false;
+
+        OpmLog::info("Restarting from the merged per-process checkpoint files of report step "
+                     + std::to_string(restartStepIdx));
+        std::vector<char> buffer;
+        int bufferSize = 0;
+        if (collectToIORank_.isIORank()) {
+            buffer.resize(Opm::Mpi::packSize(merged.restartValue, comm) +
+                          Opm::Mpi::packSize(merged.summaryState, comm));
+            Opm::Mpi::pack(merged.restartValue, buffer, bufferSize, comm);
+            Opm::Mpi::pack(merged.summaryState, buffer, bufferSize, comm);
+        }
+        comm.broadcast(&bufferSize, 1, collectToIORank_.ioRank);
+        buffer.resize(bufferSize);
+        comm.broadcast(buffer.data(), bufferSize, collectToIORank_.ioRank);
+        if (!collectToIORank_.isIORank()) {
+            int position = 0;
+            Opm::Mpi::unpack(merged.restartValue, buffer, position, comm);
+            Opm::Mpi::unpack(merged.summaryState, buffer, position, comm);
+        }
+        restartValues = std::move(merged.restartValue);
+        summaryState().deserialize(merged.summaryState);
+        return true;
+#else
+        (void) restartStepIdx;
+        (void) restartValues;
+        return false;
+#endif
+    }
+
     Opm::data::Solution computeTrans_(const std::unordered_map<int,int>& cartesianToActive) const
     {
         const auto& cartMapper = simulator_.vanguard().equilCartesianIndexMapper();
@@ -685,6 +910,70 @@ private:
         return ret;
     }
 
+    // Bookkeeping of the output requests which have been dispatched but not
+    // yet written. It is shared between the simulator thread, which waits
+    // for a free slot, and the output thread, which releases the slots.
+    class OutputQueue
+    {
+    public:
+        OutputQueue(int maxDepth, std::size_t maxMemory)
+            : maxDepth_(std::max(maxDepth, 1))
+            , maxMemory_(maxMemory)
+        { }
+
+        // Block until a request of the given size may be added, and add it.
+        void waitForSlot(std::size_t size)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto isFull = [this, size]() {
+                return pending_ >= maxDepth_
+                    || (pending_ > 0 && maxMemory_ > 0 && pendingMemory_ + size > maxMemory_);
+            };
+            if (isFull()) {
+                const auto stallStart = std::chrono::steady_clock::now();
+                slotReleased_.wait(lock, [&isFull]() { return !isFull(); });
+                stallTime_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - stallStart).count();
+                ++numStalls_;
+            }
+            ++pending_;
+            pendingMemory_ += size;
+            maxOccupancy_ = std::max(maxOccupancy_, pending_);
+            ++numRequests_;
+        }
+
+        void release(std::size_t size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --pending_;
+                pendingMemory_ -= size;
+            }
+            slotReleased_.notify_all();
+        }
+
+        std::string report() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::ostringstream os;
+            os << "ECL output queue: " << numRequests_ << " requests, maximum occupancy "
+               << maxOccupancy_ << "/" << maxDepth_ << ", stalled " << numStalls_
+               << " times for " << std::fixed << std::setprecision(2) << stallTime_ << " seconds";
+            return os.str();
+        }
+
+    private:
+        const int maxDepth_;
+        const std::size_t maxMemory_;
+        mutable std::mutex mutex_;
+        std::condition_variable slotReleased_;
+        int pending_ = 0;
+        std::size_t pendingMemory_ = 0;
+        int maxOccupancy_ = 0;
+        int numRequests_ = 0;
+        int numStalls_ = 0;
+        double stallTime_ = 0.0;
+    };
+
     struct EclWriteTasklet
         : public TaskletInterface
     {
@@ -695,32 +984,60 @@ private:
         double secondsElapsed_;
         Opm::RestartValue restartValue_;
         bool writeDoublePrecision_;
+        std::shared_ptr<OutputQueue> outputQueue_;
+        std::size_t memorySize_;
 
+        // The summary state is copied since the simulator continues to
+        // update it, the restart values are handed over by the caller.
         explicit EclWriteTasklet(const Opm::SummaryState& summaryState,
                                  Opm::EclipseIO& eclIO,
                                  int reportStepNum,
                                  bool isSubStep,
                                  double secondsElapsed,
-                                 Opm::RestartValue restartValue,
-                                 bool writeDoublePrecision)
+                                 Opm::RestartValue&& restartValue,
+                                 bool writeDoublePrecision,
+                                 std::shared_ptr<OutputQueue> outputQueue,
+                                 std::size_t memorySize)
             : summaryState_(summaryState)
             , eclIO_(eclIO)
             , reportStepNum_(reportStepNum)
             , isSubStep_(isSubStep)
             , secondsElapsed_(secondsElapsed)
-            , restartValue_(restartValue)
+            , restartValue_(std::move(restartValue))
             , writeDoublePrecision_(writeDoublePrecision)
+            , outputQueue_(std::move(outputQueue))
+            , memorySize_(memorySize)
         { }
 
+        static std::size_t memorySize(const Opm::RestartValue& restartValue)
+        {
+            std::size_t size = 0;
+            for (const auto& entry : restartValue.solution)
+                size += entry.second.data.size() * sizeof(double);
+            for (const auto& entry : restartValue.extra)
+                size += entry.second.size() * sizeof(double);
+            return size;
+        }
+
         // callback to eclIO serial writeTimeStep method
         void run()
         {
+            // release the queue slot also if the writing fails
+            struct SlotGuard {
+                OutputQueue& queue;
+                std::size_t size;
+                ~SlotGuard() { queue.release(size); }
+            } slotGuard{*outputQueue_, memorySize_};
+
             eclIO_.writeTimeStep(summaryState_,
                                  reportStepNum_,
                                  isSubStep_,
                                  secondsElapsed_,
                                  restartValue_,
                                  writeDoublePrecision_);
+
+            // the data is not needed anymore, free it before the tasklet is destroyed
+            restartValue_ = Opm::RestartValue(Opm::data::Solution{}, Opm::data::Wells{});
         }
     };
 
@@ -738,7 +1055,9 @@ private:
     EclOutputBlackOilModule<TypeTag> eclOutputModule_;
     std::unique_ptr<Opm::EclipseIO> eclIO_;
     std::unique_ptr<TaskletRunner> taskletRunner_;
+    std::shared_ptr<OutputQueue> outputQueue_;
     Scalar restartTimeStepSize_;
+    int lastRankCheckpointStep_ = -1;
 
 
 };
@@ -57,6 +57,8 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -120,26 +122,41 @@ public:
 
     double
     operator()(const double x) const
+    {
+        double u;
+        this->evaluate(&x, &u, 1);
+
+        return u;
+    }
+
+    // Evaluate at n points.  The loop has no branches and no function
+    // calls, so the compiler can vectorise it over the evaluation points.
+    void
+    evaluate(const double* x, double* u, const std::size_t n) const
     {
         // Dense output (O(h**3)) according to Shampine
         // (Hermite interpolation)
         const double h = stepsize();
-        int i = (x - span_[0]) / h;
-        const double t = (x - (span_[0] + i*h)) / h;
+        const double* y = y_.data();
+        const double* f = f_.data();
 
-        // Crude handling of evaluation point outside "span_";
-        if (i  <  0) { i = 0;      }
-        if (N_ <= i) { i = N_ - 1; }
+        for (std::size_t k = 0; k < n; ++k) {
+            int i = (x[k] - span_[0]) / h;
+            const double t = (x[k] - (span_[0] + i*h)) / h;
 
-        const double y0 = y_[i], y1 = y_[i + 1];
-        const double f0 = f_[i], f1 = f_[i + 1];
+            // Crude handling of evaluation point outside "span_";
+            i = std::min(std::max(i, 0), N_ - 1);
 
-        double u = (1 - 2*t) * (y1 - y0);
-        u += h * ((t - 1)*f0 + t*f1);
-        u *= t * (t - 1);
-        u += (1 - t)*y0 + t*y1;
+            const double y0 = y[i], y1 = y[i + 1];
+            const double f0 = f[i], f1 = f[i + 1];
 
-        return u;
+            double v = (1 - 2*t) * (y1 - y0);
+            v += h * ((t - 1)*f0 + t*f1);
+            v *= t * (t - 1);
+            v += (1 - t)*y0 + t*y1;
+
+            u[k] = v;
+        }
     }
 
 private:
@@ -307,7 +324,7 @@ public:
     ///
     /// \param[in] rhs Source object for copy initialization.
     PressureTable(const PressureTable& rhs)
-        : gravity_(rhs.gravity)
+        : gravity_(rhs.gravity_)
         , nsample_(rhs.nsample_)
     {
         this->copyInPointers(rhs);
@@ -428,6 +445,48 @@ public:
         return this->wat_->value(depth);
     }
 
+    /// Evaluate oil phase pressure at a sequence of depths.
+    ///
+    /// Batched version of \code oil(depth) \endcode which evaluates the
+    /// table once per direction as a single loop over all depths.
+    ///
+    /// \param[in] depth Depths of evaluation points.
+    ///
+    /// \param[out] press Oil phase pressure at each depth.
+    void oil(const std::vector<double>& depth,
+             std::vector<double>&       press) const
+    {
+        this->checkPtr(this->oil_.get(), "OIL");
+
+        this->oil_->value(depth, press);
+    }
+
+    /// Evaluate gas phase pressure at a sequence of depths.
+    ///
+    /// \param[in] depth Depths of evaluation points.
+    ///
+    /// \param[out] press Gas phase pressure at each depth.
+    void gas(const std::vector<double>& depth,
+             std::vector<double>&       press) const
+    {
+        this->checkPtr(this->gas_.get(), "GAS");
+
+        this->gas_->value(depth, press);
+    }
+
+    /// Evaluate water phase pressure at a sequence of depths.
+    ///
+    /// \param[in] depth Depths of evaluation points.
+    ///
+    /// \param[out] press Water phase pressure at each depth.
+    void water(const std::vector<double>& depth,
+               std::vector<double>&       press) const
+    {
+        this->checkPtr(this->wat_.get(), "WATER");
+
+        this->wat_->value(depth, press);
+    }
+
 private:
     template <class ODE>
     class PressureFunction
@@ -500,6 +559,35 @@ private:
             }
         }
 
+        void value(const std::vector<double>& depth,
+                   std::vector<double>&       press) const
+        {
+            const auto n = depth.size();
+            press.resize(n);
+
+            // Evaluate both directions at all depths and select afterwards,
+            // which keeps the table lookups free of branches.  The values
+            // below the initial condition go to a small buffer on the stack
+            // so the object can be shared between threads.
+            constexpr std::size_t chunkSize = 64;
+            std::array<double, chunkSize> below;
+
+            const auto ic = this->initial_;
+            for (std::size_t begin = 0; begin < n; begin += chunkSize) {
+                const auto len = std::min(chunkSize, n - begin);
+                const double* z = depth.data() + begin;
+                double* p = press.data() + begin;
+
+                this->value_[Direction::Up]->evaluate(z, p, len);
+                this->value_[Direction::Down]->evaluate(z, below.data(), len);
+
+                for (std::size_t i = 0; i < len; ++i) {
+                    p[i] = (z[i] > ic.depth) ? below[i]
+                        : ((z[i] < ic.depth) ? p[i] : ic.pressure);
+                }
+            }
+        }
+
     private:
         enum Direction : std::size_t { Up, Down, NumDir };
 
@@ -847,11 +935,9 @@ public:
         , swatInit_ (rhs.swatInit_)
         , sat_      (rhs.sat_)
         , press_    (rhs.press_)
+        , evalPt_   (rhs.evalPt_)
     {
         // Note: We don't need to do anything to the 'fluidState_' here.
-        this->setEvaluationPoint(*rhs.evalPt_.position,
-                                 *rhs.evalPt_.region,
-                                 *rhs.evalPt_.ptable);
     }
 
     /// Disabled assignment operator.
@@ -880,18 +966,37 @@ public:
         this->setEvaluationPoint(x, reg, ptable);
         this->initializePhaseQuantities();
 
-        if (ptable.waterActive()) { this->deriveWaterSat(); }
-        if (ptable.gasActive())   { this->deriveGasSat();   }
-
-        if (this->isOverlappingTransition()) {
-            this->fixUnphysicalTransition();
-        }
-
-        if (ptable.oilActive()) { this->deriveOilSat(); }
+        return this->deriveSaturationsAtEvaluationPoint();
+    }
 
-        this->accountForScaledSaturations();
+    /// Calculate phase saturations at particular point of the simulation
+    /// model geometry from phase pressures which have already been looked
+    /// up in the pressure table, e.g., by the batched lookup over all
+    /// evaluation points of a cell.
+    ///
+    /// \param[in] x Specific geometric point (depth within a specific cell).
+    ///
+    /// \param[in] reg Equilibration information for a single equilibration
+    ///    region; notably contact depths.
+    ///
+    /// \param[in] ptable Previously equilibrated phase pressure table
+    ///    pertaining to the equilibration region \p reg.
+    ///
+    /// \param[in] press Phase pressures from \p ptable at depth of \p x.
+    ///    Zero for inactive phases.
+    ///
+    /// \return Set of phase saturation values defined at particular point.
+    const PhaseQuantityValue&
+    deriveSaturations(const Position&           x,
+                      const Region&             reg,
+                      const PTable&             ptable,
+                      const PhaseQuantityValue& press)
+    {
+        this->setEvaluationPoint(x, reg, ptable);
+        this->sat_.reset();
+        this->press_ = press;
 
-        return this->sat_;
+        return this->deriveSaturationsAtEvaluationPoint();
     }
 
     /// Retrieve saturation-corrected phase pressures
@@ -974,6 +1079,26 @@ private:
         this->evalPt_.ptable   = &ptable;
     }
 
+    /// Derive the phase saturations from the phase pressures at the
+    /// current evaluation point.
+    const PhaseQuantityValue& deriveSaturationsAtEvaluationPoint()
+    {
+        const auto& ptable = *this->evalPt_.ptable;
+
+        if (ptable.waterActive()) { this->deriveWaterSat(); }
+        if (ptable.gasActive())   { this->deriveGasSat();   }
+
+        if (this->isOverlappingTransition()) {
+            this->fixUnphysicalTransition();
+        }
+
+        if (ptable.oilActive()) { this->deriveOilSat(); }
+
+        this->accountForScaledSaturations();
+
+        return this->sat_;
+    }
+
     /// Initialize phase saturation and phase pressure values.
     ///
     /// Looks up phase pressure values from the input pressure table.
@@ -1337,8 +1462,18 @@ template <class MaterialLawManager, class FluidSystem, class Region, typename Ce
 double PhaseSaturations<MaterialLawManager, FluidSystem, Region, CellID>::
 applySwatInit(const double pcow, const double sw)
 {
-    return this->matLawMgr_
+    // The material law manager is shared by all threads of the cell loop.
+    // Rescaling the capillary pressure only touches the parameters of the
+    // current cell, but the manager does not promise that this is safe to
+    // do concurrently.
+    auto swat = sw;
+#ifdef _OPENMP
+#pragma omp critical(EquilApplySwatinit)
+#endif
+    swat = this->matLawMgr_
         .applySwatinit(this->evalPt_.position->cell, pcow, sw);
+
+    return swat;
 }
 
 template <class MaterialLawManager, class FluidSystem, class Region, typename CellID>
@@ -1759,49 +1894,92 @@ private:
         using PhaseSat = Details::PhaseSaturations<
             MaterialLawManager, FluidSystem, EquilReg, typename RMap::CellId
         >;
+        using PTable = Details::PressureTable<FluidSystem, EquilReg>;
 
-        auto ptable = Details::PressureTable<FluidSystem, EquilReg>{ grav };
-        auto psat   = PhaseSat { materialLawManager, this->swatInit_ };
-        auto vspan  = std::array<double, 2>{};
-
+        auto regions = std::vector<int>{};
         for (const auto& r : reg.activeRegions()) {
-            const auto& cells = reg.cells(r);
-            if (cells.empty()) {
+            if (reg.cells(r).empty()) {
                 Opm::OpmLog::warning("Equilibration region " + std::to_string(r + 1)
                                      + " has no active cells");
                 continue;
             }
 
-            Details::verticalExtent(grid, cells, vspan);
+            regions.push_back(r);
+        }
 
-            const auto eqreg = EquilReg {
+        const auto makeEquilReg = [this, &rec](const int r)
+        {
+            return EquilReg {
                 rec[r], this->rsFunc_[r], this->rvFunc_[r], this->regionPvtIdx_[r]
             };
+        };
 
-            // Ensure gas/oil and oil/water contacts are within the span for the
-            // phase pressure calculation.
-            vspan[0] = std::min(vspan[0], std::min(eqreg.zgoc(), eqreg.zwoc()));
-            vspan[1] = std::max(vspan[1], std::max(eqreg.zgoc(), eqreg.zwoc()));
+        // The phase pressure tables of the regions are independent of each
+        // other, so they are computed concurrently.
+        const int numRegions = regions.size();
+        auto ptables = std::vector<PTable>(numRegions, PTable { grav });
+        std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < numRegions; ++i) {
+            try {
+                const auto r = regions[i];
+                auto vspan = std::array<double, 2>{};
+                Details::verticalExtent(grid, reg.cells(r), vspan);
+
+                const auto eqreg = makeEquilReg(r);
+
+                // Ensure gas/oil and oil/water contacts are within the span for the
+                // phase pressure calculation.
+                vspan[0] = std::min(vspan[0], std::min(eqreg.zgoc(), eqreg.zwoc()));
+                vspan[1] = std::max(vspan[1], std::max(eqreg.zgoc(), eqreg.zwoc()));
+
+                ptables[i].equilibrate(eqreg, vspan);
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                exception = std::current_exception();
+            }
+        }
+        if (exception)
+            std::rethrow_exception(exception);
 
-            ptable.equilibrate(eqreg, vspan);
+        const auto psat = PhaseSat { materialLawManager, this->swatInit_ };
+        for (int i = 0; i < numRegions; ++i) {
+            const auto r = regions[i];
+            const auto& cells = reg.cells(r);
+            const auto eqreg = makeEquilReg(r);
 
             const auto acc = eqreg.equilibrationAccuracy();
             if (acc == 0) {
                 // Centre-point method
-                this->equilibrateCellCentres(cells, eqreg, grid, ptable, psat);
+                this->equilibrateCellCentres(cells, eqreg, grid, ptables[i], psat);
             }
             else if (acc < 0) {
                 // Horizontal subdivision
                 this->equilibrateHorizontal(cells, eqreg, -acc,
-                                            grid, ptable, psat);
+                                            grid, ptables[i], psat);
             }
         }
     }
 
+    /// Apply an equilibration method to all cells of a region.
+    ///
+    /// The cells are distributed over the threads.  Every thread works on
+    /// its own copy of \p eqmethod, so a method may keep mutable state such
+    /// as its own phase saturation calculator and scratch buffers.  Note
+    /// that SWATINIT updates the material law parameters of the cell that
+    /// is being processed only, and that these updates are serialised.
     template <class CellRange, class EquilibrationMethod>
-    void cellLoop(const CellRange&      cells,
-                  EquilibrationMethod&& eqmethod)
+    void cellLoop(const CellRange&           cells,
+                  const EquilibrationMethod& eqmethod)
     {
+        using CellID = std::remove_cv_t<std::remove_reference_t<
+            decltype(*std::begin(cells))>>;
+
         const auto oilPos = FluidSystem::oilPhaseIdx;
         const auto gasPos = FluidSystem::gasPhaseIdx;
         const auto watPos = FluidSystem::waterPhaseIdx;
@@ -1810,34 +1988,61 @@ private:
         const auto gasActive = FluidSystem::phaseIsActive(gasPos);
         const auto watActive = FluidSystem::phaseIsActive(watPos);
 
-        auto pressures   = Details::PhaseQuantityValue{};
-        auto saturations = Details::PhaseQuantityValue{};
-        auto Rs          = 0.0;
-        auto Rv          = 0.0;
-
-        for (const auto& cell : cells) {
-            eqmethod(cell, pressures, saturations, Rs, Rv);
+        const auto cellIds = std::vector<CellID>(std::begin(cells), std::end(cells));
+        const int numCells = cellIds.size();
 
-            if (oilActive) {
-                this->pp_ [oilPos][cell] = pressures.oil;
-                this->sat_[oilPos][cell] = saturations.oil;
-            }
+        // exceptions must not leave an OpenMP region, they are rethrown
+        // after the loop.
+        std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            auto threadMethod = eqmethod;
+
+            auto pressures   = Details::PhaseQuantityValue{};
+            auto saturations = Details::PhaseQuantityValue{};
+            auto Rs          = 0.0;
+            auto Rv          = 0.0;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+            for (int i = 0; i < numCells; ++i) {
+                try {
+                    const auto cell = cellIds[i];
+                    threadMethod(cell, pressures, saturations, Rs, Rv);
+
+                    if (oilActive) {
+                        this->pp_ [oilPos][cell] = pressures.oil;
+                        this->sat_[oilPos][cell] = saturations.oil;
+                    }
 
-            if (gasActive) {
-                this->pp_ [gasPos][cell] = pressures.gas;
-                this->sat_[gasPos][cell] = saturations.gas;
-            }
+                    if (gasActive) {
+                        this->pp_ [gasPos][cell] = pressures.gas;
+                        this->sat_[gasPos][cell] = saturations.gas;
+                    }
 
-            if (watActive) {
-                this->pp_ [watPos][cell] = pressures.water;
-                this->sat_[watPos][cell] = saturations.water;
-            }
+                    if (watActive) {
+                        this->pp_ [watPos][cell] = pressures.water;
+                        this->sat_[watPos][cell] = saturations.water;
+                    }
 
-            if (oilActive && gasActive) {
-                this->rs_[cell] = Rs;
-                this->rv_[cell] = Rv;
+                    if (oilActive && gasActive) {
+                        this->rs_[cell] = Rs;
+                        this->rv_[cell] = Rv;
+                    }
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exception = std::current_exception();
+                }
             }
         }
+        if (exception)
+            std::rethrow_exception(exception);
     }
 
     template <class CellRange, class Grid, class PressTable, class PhaseSat>
@@ -1845,18 +2050,18 @@ private:
                                 const EquilReg&   eqreg,
                                 const Grid&       grid,
                                 const PressTable& ptable,
-                                PhaseSat&         psat)
+                                const PhaseSat&   psat)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
 
-        this->cellLoop(cells, [this, &eqreg, &grid, &ptable, &psat]
+        this->cellLoop(cells, [this, &eqreg, &grid, &ptable, psat = PhaseSat(psat)]
             (const CellID                 cell,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
-             double&                      Rv) -> void
+             double&                      Rv) mutable -> void
         {
             const auto pos = CellPos {
                 cell, UgGridHelpers::cellCenterDepth(grid, cell)
@@ -1881,27 +2086,51 @@ private:
                                const int         acc,
                                const Grid&       grid,
                                const PressTable& ptable,
-                               PhaseSat&         psat)
+                               const PhaseSat&   psat)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
 
-        this->cellLoop(cells, [this, acc, &eqreg, &grid, &ptable, &psat]
+        // Scratch buffers for the batched phase pressure lookup at the
+        // sub-division depths of a cell, owned by each thread's copy of the
+        // method.
+        auto depths = std::vector<double>{};
+        auto phasePress = std::array<std::vector<double>, 3>{};
+
+        this->cellLoop(cells, [this, acc, &eqreg, &grid, &ptable, psat = PhaseSat(psat), depths, phasePress]
             (const CellID                 cell,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
-             double&                      Rv) -> void
+             double&                      Rv) mutable -> void
         {
             pressures  .reset();
             saturations.reset();
 
+            const auto subdiv = Details::horizontalSubdivision(grid, cell, acc);
+
+            depths.clear();
+            for (const auto& point : subdiv) {
+                depths.push_back(point.first);
+            }
+
+            auto& [oilPress, gasPress, watPress] = phasePress;
+            if (ptable.oilActive())   { ptable.oil  (depths, oilPress); }
+            if (ptable.gasActive())   { ptable.gas  (depths, gasPress); }
+            if (ptable.waterActive()) { ptable.water(depths, watPress); }
+
             auto totfrac = 0.0;
-            for (const auto& [depth, frac] : Details::horizontalSubdivision(grid, cell, acc)) {
-                const auto pos = CellPos { cell, depth };
+            for (std::size_t i = 0; i < subdiv.size(); ++i) {
+                const auto pos = CellPos { cell, subdiv[i].first };
+                const auto frac = subdiv[i].second;
+
+                auto press = Details::PhaseQuantityValue{};
+                if (ptable.oilActive())   { press.oil   = oilPress[i]; }
+                if (ptable.gasActive())   { press.gas   = gasPress[i]; }
+                if (ptable.waterActive()) { press.water = watPress[i]; }
 
-                saturations.axpy(psat.deriveSaturations(pos, eqreg, ptable), frac);
+                saturations.axpy(psat.deriveSaturations(pos, eqreg, ptable, press), frac);
                 pressures  .axpy(psat.correctedPhasePressures(), frac);
 
                 totfrac += frac;
@@ -20,6 +20,7 @@
 #define FLOW_SUPPORT_AMG 1
 
 #include <flow/flow_ebos_blackoil.hpp>
+#include <opm/simulators/flow/Main.hpp>
 
 #include <opm/material/common/ResetLocale.hpp>
 #include <opm/grid/CpGrid.hpp>
@@ -63,4 +64,46 @@ int flowEbosBlackoilMain(int argc, char** argv, bool outputCout, bool outputFile
     return mainfunc.execute(argc, argv, outputCout, outputFiles);
 }
 
+// Set up the simulation but do not run any report step. The returned object
+// advances the simulation by executeStep(), this is used by the Python bindings.
+std::unique_ptr<Opm::FlowMainEbos<TTAG(EclFlowProblem)>>
+flowEbosBlackoilMainInit(int argc, char** argv, bool outputCout, bool outputFiles)
+{
+    // we always want to use the default locale, and thus spare us the trouble
+    // with incorrect locale settings.
+    Opm::resetLocale();
+
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+    Dune::MPIHelper::instance(argc, argv);
+#endif
+
+    auto mainfunc = std::make_unique<Opm::FlowMainEbos<TTAG(EclFlowProblem)>>();
+    if (mainfunc->executeInitStep(argc, argv, outputCout, outputFiles) != EXIT_SUCCESS)
+        return nullptr;
+    return mainfunc;
+}
+
+std::unique_ptr<Opm::FlowMainEbos<TTAG(EclFlowProblem)>>
+Main::initFlowEbosBlackoil(int& exitCode)
+{
+    exitCode = EXIT_SUCCESS;
+    if (!initialize_<TTAG(FlowEarlyBird)>(exitCode))
+        return nullptr;
+
+    if (eclipseState_->runspec().phases().size() != 3) {
+        if (outputCout_)
+            std::cerr << "Only blackoil cases can be run step by step." << std::endl;
+        exitCode = EXIT_FAILURE;
+        return nullptr;
+    }
+
+    flowEbosBlackoilSetDeck(setupTime_, deck_.get(), *eclipseState_, *schedule_, *summaryConfig_);
+    auto mainfunc = flowEbosBlackoilMainInit(argc_, argv_, outputCout_, outputFiles_);
+    if (!mainfunc)
+        exitCode = EXIT_FAILURE;
+    return mainfunc;
+}
+
 }
@@ -26,6 +26,7 @@
 
 #include <ebos/eclproblem.hh>
 #include <opm/models/utils/start.hh>
+#include <opm/models/parallel/threadedentityiterator.hh>
 
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 
@@ -35,6 +36,7 @@
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/wells/WellConnectionAuxiliaryModule.hpp>
 #include <opm/simulators/flow/countGlobalCells.hpp>
+#include <opm/simulators/flow/partitionCells.hpp>
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
@@ -50,9 +52,12 @@
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 #include <opm/simulators/linalg/ISTLSolverEbos.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 
+#include <dune/istl/operators.hh>
 #include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/solvers.hh>
 #if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
 #include <dune/common/parallel/communication.hh>
 #else
@@ -63,12 +68,17 @@
 
 #include <cassert>
 #include <cmath>
+#include <exception>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <set>
 #include <vector>
 #include <algorithm>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 BEGIN_PROPERTIES
 
@@ -121,6 +131,10 @@ namespace Opm {
         typedef typename GET_PROP_TYPE(TypeTag, Indices)           Indices;
         typedef typename GET_PROP_TYPE(TypeTag, MaterialLaw)       MaterialLaw;
         typedef typename GET_PROP_TYPE(TypeTag, MaterialLawParams) MaterialLawParams;
+        typedef typename GET_PROP_TYPE(TypeTag, GridView)          GridView;
+        typedef typename GET_PROP_TYPE(TypeTag, LocalResidual)     LocalResidual;
+        typedef typename LocalResidual::LocalEvalBlockVector       LocalEvalBlockVector;
+        typedef typename GridView::template Codim<0>::Entity       Element;
 
         typedef double Scalar;
         static const int numEq = Indices::numEq;
@@ -143,6 +157,18 @@ namespace Opm {
         typedef Dune::BlockVector<VectorBlockType>      BVector;
 
         typedef ISTLSolverEbos<TypeTag> ISTLSolverType;
+
+        /// A subdomain of the local solves.
+        struct LocalDomain
+        {
+            int index = 0;
+            std::vector<Element> elements;
+            /// The cell of each element, the position in this list is the
+            /// row of the cell in the Jacobian.
+            std::vector<int> cells;
+            Mat jacobian;
+        };
+
         //typedef typename SolutionVector :: value_type            PrimaryVariables ;
 
         // ---------  Public methods  ---------
@@ -177,6 +203,7 @@ namespace Opm {
         , terminal_output_ (terminal_output)
         , current_relaxation_(1.0)
         , dx_old_(UgGridHelpers::numCells(grid_))
+        , chord_iterations_(0)
         {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
@@ -248,11 +275,38 @@ namespace Opm {
                 convergence_reports_.back().report.reserve(11);
             }
 
+            // A chord iteration reuses the Jacobian and the preconditioner of an
+            // earlier iteration, so the derivatives of the reservoir equations
+            // are not added to the matrix.
+            const bool chord = useChordIteration(iteration, nonlinear_solver);
+            chord_iterations_ = chord ? chord_iterations_ + 1 : 0;
+
+            // Solve the subdomains by local Newton iterations, the global
+            // iteration below then corrects the coupling between them.
+            if (param_.num_local_domains_ > 0 && !chord) {
+                try {
+                    solveLocalDomains(timer, iteration, report);
+                    report.local_solve_time += perfTimer.stop();
+                }
+                catch (...) {
+                    report.local_solve_time += perfTimer.stop();
+                    failureReport_ += report;
+                    throw;
+                }
+                perfTimer.reset();
+                perfTimer.start();
+            }
+
             report.total_linearizations = 1;
 
             try {
-                report += assembleReservoir(timer, iteration);
-                report.assemble_time += perfTimer.stop();
+                report += assembleReservoir(timer, iteration, chord);
+                const double assembleTime = perfTimer.stop();
+                report.assemble_time += assembleTime;
+                if (chord) {
+                    report.total_residual_evaluations = 1;
+                    report.residual_assemble_time += assembleTime;
+                }
             }
             catch (...) {
                 report.assemble_time += perfTimer.stop();
@@ -294,13 +348,16 @@ namespace Opm {
 
                 // apply the Schur compliment of the well model to the reservoir linearized
                 // equations
-                wellModel().linearize(ebosSimulator().model().linearizer().jacobian(),
-                                      ebosSimulator().model().linearizer().residual());
+                if (chord)
+                    wellModel().linearizeResidual(ebosSimulator().model().linearizer().residual());
+                else
+                    wellModel().linearize(ebosSimulator().model().linearizer().jacobian(),
+                                          ebosSimulator().model().linearizer().residual());
 
                 // Solve the linear system.
                 linear_solve_setup_time_ = 0.0;
                 try {
-                    solveJacobianSystem(x);
+                    solveJacobianSystem(x, chord);
                     report.linear_solve_setup_time += linear_solve_setup_time_;
                     report.linear_solve_time += perfTimer.stop();
                     report.total_linear_iterations += linearIterationsLastSolve();
@@ -368,18 +425,339 @@ namespace Opm {
         /// \param[in]      reservoir_state   reservoir state variables
         /// \param[in, out] well_state        well state variables
         /// \param[in]      initial_assembly  pass true if this is the first call to assemble() in this timestep
+        /// \param[in]      keepJacobian      pass true to leave the Jacobian of the reservoir as it is
         SimulatorReportSingle assembleReservoir(const SimulatorTimerInterface& /* timer */,
-                                                const int iterationIdx)
+                                                const int iterationIdx,
+                                                const bool keepJacobian = false)
         {
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
-            ebosSimulator_.model().linearizer().linearizeDomain();
+            if (keepJacobian)
+                evaluateResidual();
+            else
+                ebosSimulator_.model().linearizer().linearizeDomain();
             ebosSimulator_.problem().endIteration();
 
             return wellModel().lastReport();
         }
 
+        /// Evaluate the residual of the mass balance equations into the residual
+        /// of the linearizer without adding the derivatives to its Jacobian.
+        ///
+        /// The local residuals are the ones of the linearizer and they are still
+        /// evaluated with derivatives, since the intensive quantities and the
+        /// local residual only exist for the Evaluation type. Only the scatter
+        /// of the derivatives into the sparse matrix is saved; the final report
+        /// compares the time of these evaluations with full linearizations.
+        /// Each element only contributes to the row of its own cell, so the
+        /// threads need no synchronization.
+        void evaluateResidual()
+        {
+            auto& residual = ebosSimulator_.model().linearizer().residual();
+            const auto& model = ebosSimulator_.model();
+            Opm::ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(ebosSimulator_.gridView());
+            std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+#ifdef _OPENMP
+                const std::size_t threadId = omp_get_thread_num();
+#else
+                const std::size_t threadId = 0;
+#endif
+                ElementContext elemCtx(ebosSimulator_);
+                const auto& localResidual = model.localLinearizer(threadId).localResidual();
+                LocalEvalBlockVector localResid;
+                auto elemIt = threadedElemIt.beginParallel();
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    try {
+                        elemCtx.updateAll(*elemIt);
+                        localResid.resize(elemCtx.numDof(/*timeIdx=*/0));
+                        localResidual.eval(localResid, elemCtx);
+
+                        const unsigned globalIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                        for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                            residual[globalIdx][eqIdx] = Opm::getValue(localResid[/*dofIdx=*/0][eqIdx]);
+                        }
+                    }
+                    catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        exception = std::current_exception();
+                    }
+                }
+            }
+
+            // All processes have to leave the iteration together, otherwise the
+            // ones that succeeded wait in the collectives of the wells and the
+            // linear solver.
+            int succeeded = exception ? 0 : 1;
+            succeeded = ebosSimulator_.gridView().comm().min(succeeded);
+            if (exception)
+                std::rethrow_exception(exception);
+            if (!succeeded)
+                OPM_THROW(Opm::NumericalIssue, "A process did not succeed in evaluating the residual");
+        }
+
+        /// Solve each subdomain by local Newton iterations while the solution
+        /// outside of it is kept fixed.
+        ///
+        /// The subdomains are solved one after the other, so each one sees the
+        /// updated solution of the ones solved before it. The wells and the
+        /// aquifers enter with the rates of their last linearization. If the
+        /// solve of a subdomain fails on any process, e.g. because the
+        /// intensive quantities cannot be computed for an update, the local
+        /// updates are discarded on all processes.
+        void solveLocalDomains(const SimulatorTimerInterface& timer,
+                               const int iteration,
+                               SimulatorReportSingle& report)
+        {
+            if (local_domains_.empty())
+                setupLocalDomains();
+
+            const double tol_cnv = (iteration < param_.max_strict_iter_) ? param_.tolerance_cnv_ : param_.tolerance_cnv_relaxed_;
+            const double tolerance = param_.local_tolerance_scaling_cnv_ * tol_cnv;
+
+            auto& ebosModel = ebosSimulator_.model();
+            const auto initialSolution = ebosModel.solution(/*timeIdx=*/0);
+
+            report.domain_newton_iterations.assign(local_domains_.size(), 0);
+            int succeeded = 1;
+            for (auto& domain : local_domains_) {
+                try {
+                    const int iterations = solveLocalDomain(domain, timer.currentStepLength(), tolerance);
+                    report.domain_newton_iterations[domain.index] = iterations;
+                    report.total_local_newton_iterations += iterations;
+                }
+                catch (const std::exception& e) {
+                    OpmLog::debug("Local solve of domain " + std::to_string(domain.index) + " failed: " + e.what());
+                    succeeded = 0;
+                    break;
+                }
+            }
+
+            // All processes have to take the same path into the collectives of
+            // the global iteration. The local solves only accelerate it, so a
+            // failure does not need to cut the time step.
+            succeeded = ebosSimulator_.gridView().comm().min(succeeded);
+            if (!succeeded) {
+                ebosModel.solution(/*timeIdx=*/0) = initialSolution;
+                ebosModel.invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+                return;
+            }
+
+            // the copies of the updated cells on the other processes are outdated
+            if (isParallel()) {
+                ebosSimulator_.model().syncOverlap();
+                ebosSimulator_.model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+            }
+        }
+
+        /// Split the interior cells of this process into subdomains.
+        void setupLocalDomains()
+        {
+            const auto& gridView = ebosSimulator_.gridView();
+            const int numCells = ebosSimulator_.model().numGridDof();
+            ElementContext elemCtx(ebosSimulator_);
+
+            std::vector<Element> interiorElements;
+            std::vector<int> interiorIdx(numCells, -1);
+            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+            {
+                elemCtx.updatePrimaryStencil(*elemIt);
+                interiorIdx[elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0)] = interiorElements.size();
+                interiorElements.push_back(*elemIt);
+            }
+
+            // the connections between the interior cells
+            std::vector<int> neighborStart(1, 0);
+            std::vector<int> neighbors;
+            for (const auto& elem : interiorElements) {
+                elemCtx.updateStencil(elem);
+                for (unsigned dofIdx = 1; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                    const int neighborIdx = interiorIdx[elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0)];
+                    if (neighborIdx >= 0)
+                        neighbors.push_back(neighborIdx);
+                }
+                neighborStart.push_back(neighbors.size());
+            }
+            const std::vector<int> domainOfCell = partitionCells(param_.num_local_domains_, neighborStart, neighbors);
+
+            const int numDomains = domainOfCell.empty() ? 0 : *std::max_element(domainOfCell.begin(), domainOfCell.end()) + 1;
+            local_domains_.resize(numDomains);
+            cell_domain_.assign(numCells, -1);
+            local_index_.assign(numCells, -1);
+            for (std::size_t i = 0; i < interiorElements.size(); ++i) {
+                auto& domain = local_domains_[domainOfCell[i]];
+                elemCtx.updatePrimaryStencil(interiorElements[i]);
+                const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                cell_domain_[cellIdx] = domainOfCell[i];
+                local_index_[cellIdx] = domain.cells.size();
+                domain.cells.push_back(cellIdx);
+                domain.elements.push_back(interiorElements[i]);
+            }
+
+            // the sparsity pattern of the Jacobian of each subdomain only contains
+            // the connections inside of it
+            for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+                auto& domain = local_domains_[domainIdx];
+                domain.index = domainIdx;
+                const std::size_t n = domain.cells.size();
+                std::vector<std::set<int>> pattern(n);
+                std::size_t nnz = 0;
+                for (std::size_t localIdx = 0; localIdx < n; ++localIdx) {
+                    elemCtx.updateStencil(domain.elements[localIdx]);
+                    for (unsigned dofIdx = 0; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                        const unsigned globJ = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
+                        if (cell_domain_[globJ] == domainIdx && pattern[local_index_[globJ]].insert(localIdx).second)
+                            ++nnz;
+                    }
+                }
+
+                domain.jacobian.setBuildMode(Mat::row_wise);
+                domain.jacobian.setSize(n, n, nnz);
+                for (auto row = domain.jacobian.createbegin(); row != domain.jacobian.createend(); ++row) {
+                    for (const int colIdx : pattern[row.index()])
+                        row.insert(colIdx);
+                }
+            }
+        }
+
+        /// Solve a subdomain by Newton iterations and return their number.
+        ///
+        /// The iterations also stop without convergence if the linear solver
+        /// fails, the global iteration which follows takes care of the rest.
+        int solveLocalDomain(LocalDomain& domain, const double dt, const double tolerance)
+        {
+            // the subdomains are small, so a moderate reduction of the linear
+            // residual suffices
+            const double linearReduction = 1e-3;
+            const int maxLinearIterations = 200;
+
+            auto& ebosModel = ebosSimulator_.model();
+            auto& solution = ebosModel.solution(/*timeIdx=*/0);
+            const std::size_t n = domain.cells.size();
+            BVector residual(n);
+            BVector dx(n);
+            int iteration = 0;
+            for (; iteration < param_.max_local_solve_iterations_; ++iteration) {
+                const double cnv = assembleLocalDomain(domain, dt, residual);
+                if (!std::isfinite(cnv) || cnv <= tolerance)
+                    break;
+
+                dx = 0.0;
+                Dune::InverseOperatorResult result;
+                try {
+                    Dune::MatrixAdapter<Mat, BVector, BVector> op(domain.jacobian);
+                    ParallelOverlappingILU0<Mat, BVector, BVector> precond(domain.jacobian, 1.0, MILU_VARIANT::ILU);
+                    Dune::BiCGSTABSolver<BVector> solver(op, precond, linearReduction, maxLinearIterations, /*verbose=*/0);
+                    solver.apply(dx, residual, result);
+                }
+                catch (const Dune::Exception&) {
+                    break;
+                }
+                if (!result.converged)
+                    break;
+
+                ebosModel.newtonMethod().updateDofs(solution, domain.cells, dx);
+                for (const int cellIdx : domain.cells)
+                    ebosModel.setIntensiveQuantitiesCacheEntryValidity(cellIdx, /*timeIdx=*/0, false);
+            }
+
+            return iteration;
+        }
+
+        /// Linearize the mass balance equations of a subdomain and return the
+        /// CNV error of its residual.
+        double assembleLocalDomain(LocalDomain& domain, const double dt, BVector& residual)
+        {
+            const auto& ebosModel = ebosSimulator_.model();
+            const auto& ebosProblem = ebosSimulator_.problem();
+            const auto& localResidual = ebosModel.localLinearizer(/*threadId=*/0).localResidual();
+            ElementContext elemCtx(ebosSimulator_);
+            LocalEvalBlockVector localResid;
+
+            domain.jacobian = 0.0;
+            std::vector<Scalar> B_avg(numEq, 0.0);
+            std::vector<Scalar> maxCoeff(numEq, 0.0);
+            bool finite = true;
+            for (std::size_t localIdx = 0; localIdx < domain.elements.size(); ++localIdx) {
+                // the derivatives are the ones with respect to the primary
+                // variables of the element's own cell, i.e. each element
+                // yields one column of the Jacobian
+                elemCtx.updateStencil(domain.elements[localIdx]);
+                elemCtx.updateAllIntensiveQuantities();
+                elemCtx.setFocusDofIndex(/*dofIdx=*/0);
+                elemCtx.updateAllExtensiveQuantities();
+                localResid.resize(elemCtx.numDof(/*timeIdx=*/0));
+                localResidual.eval(localResid, elemCtx);
+
+                for (unsigned dofIdx = 0; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                    const unsigned globJ = elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0);
+                    if (cell_domain_[globJ] != domain.index)
+                        continue;
+
+                    auto& block = domain.jacobian[local_index_[globJ]][localIdx];
+                    for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                        for (unsigned pvIdx = 0; pvIdx < numEq; ++pvIdx)
+                            block[eqIdx][pvIdx] += localResid[dofIdx][eqIdx].derivative(pvIdx);
+                    }
+                }
+
+                const unsigned cellIdx = domain.cells[localIdx];
+                const double pvValue = ebosProblem.referencePorosity(cellIdx, /*timeIdx=*/0) * ebosModel.dofTotalVolume(cellIdx);
+                addFormationVolumeFactors(elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0), B_avg);
+                for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                    const double R = Opm::getValue(localResid[/*dofIdx=*/0][eqIdx]);
+                    residual[localIdx][eqIdx] = R;
+                    finite = finite && std::isfinite(R);
+                    maxCoeff[eqIdx] = std::max(maxCoeff[eqIdx], std::abs(R) / pvValue);
+                }
+            }
+
+            if (!finite)
+                return std::numeric_limits<double>::quiet_NaN();
+
+            double cnv = 0.0;
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                cnv = std::max(cnv, B_avg[eqIdx] / domain.cells.size() * dt * maxCoeff[eqIdx]);
+            return cnv;
+        }
+
+        /// Add the formation volume factors which scale the residual of each
+        /// equation in the CNV measure.
+        template <class IntensiveQuantities>
+        void addFormationVolumeFactors(const IntensiveQuantities& intQuants,
+                                       std::vector<Scalar>& B)
+        {
+            const auto& fs = intQuants.fluidState();
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                    continue;
+                }
+                const unsigned compIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
+                B[compIdx] += 1.0 / fs.invB(phaseIdx).value();
+            }
+            if (has_solvent_)
+                B[contiSolventEqIdx] += 1.0 / intQuants.solventInverseFormationVolumeFactor().value();
+            if (has_polymer_)
+                B[contiPolymerEqIdx] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+            if (has_foam_)
+                B[contiFoamEqIdx] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
+            if (has_brine_)
+                B[contiBrineEqIdx] += 1.0 / fs.invB(FluidSystem::gasPhaseIdx).value();
+            if (has_polymermw_)
+                B[contiPolymerMWEqIdx] += 1.0 / fs.invB(FluidSystem::waterPhaseIdx).value();
+            if (has_energy_)
+                B[contiEnergyEqIdx] += 1.0;
+        }
+
         // compute the "relative" change of the solution between time steps
         double relativeChange() const
         {
@@ -465,6 +843,38 @@ namespace Opm {
         }
 
 
+        /// Whether an iteration reuses the Jacobian and the preconditioner of
+        /// an earlier iteration (a chord or Shamanskii iteration), so that the
+        /// Jacobian is not assembled. This is the case if the residuals
+        /// of all phases were reduced by at least the chord contraction rate in
+        /// the previous iteration and no oscillation or stagnation is detected.
+        template <class NonlinearSolverType>
+        bool useChordIteration(const int iteration, const NonlinearSolverType& nonlinear_solver) const
+        {
+            if (!param_.use_chord_newton_ || iteration < 2
+                || chord_iterations_ >= param_.max_chord_iterations_) {
+                return false;
+            }
+
+            const int last = iteration - 1;
+            bool isOscillate = false;
+            bool isStagnate = false;
+            nonlinear_solver.detectOscillations(residual_norms_history_, last, isOscillate, isStagnate);
+            if (isOscillate || isStagnate) {
+                return false;
+            }
+
+            const auto& F0 = residual_norms_history_[last];
+            const auto& F1 = residual_norms_history_[last - 1];
+            double contraction = 0.0;
+            for (std::size_t p = 0; p < F0.size(); ++p) {
+                if (F1[p] > 0.0) {
+                    contraction = std::max(contraction, F0[p] / F1[p]);
+                }
+            }
+            return contraction < param_.chord_contraction_rate_;
+        }
+
         /// Number of linear iterations used in last call to solveJacobianSystem().
         int linearIterationsLastSolve() const
         {
@@ -473,7 +883,9 @@ namespace Opm {
 
         /// Solve the Jacobian system Jx = r where J is the Jacobian and
         /// r is the residual.
-        void solveJacobianSystem(BVector& x)
+        /// \param[in] chord  if true, J is the Jacobian of the last iteration
+        ///                   which was not a chord iteration
+        void solveJacobianSystem(BVector& x, const bool chord = false)
         {
 
             auto& ebosJac = ebosSimulator_.model().linearizer().jacobian();
@@ -485,7 +897,10 @@ namespace Opm {
             auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
             Dune::Timer perfTimer;
             perfTimer.start();
-            ebosSolver.prepare(ebosJac, ebosResid);
+            if (chord)
+                ebosSolver.prepareResidual(ebosResid);
+            else
+                ebosSolver.prepare(ebosJac, ebosResid);
             linear_solve_setup_time_ = perfTimer.stop();
             ebosSolver.setResidual(ebosResid);
             // actually, the error needs to be calculated after setResidual in order to
@@ -898,6 +1313,13 @@ namespace Opm {
         std::vector<std::vector<double>> residual_norms_history_;
         double current_relaxation_;
         BVector dx_old_;
+        int chord_iterations_;
+
+        std::vector<LocalDomain> local_domains_;
+        /// The subdomain of each cell, -1 for the cells of other processes.
+        std::vector<int> cell_domain_;
+        /// The position of each cell in the cell list of its subdomain.
+        std::vector<int> local_index_;
 
         std::vector<StepReport> convergence_reports_;
     public:
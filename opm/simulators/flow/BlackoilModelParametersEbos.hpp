@@ -47,6 +47,12 @@ NEW_PROP_TAG(MaxStrictIter);
 NEW_PROP_TAG(SolveWelleqInitially);
 NEW_PROP_TAG(UpdateEquationsScaling);
 NEW_PROP_TAG(UseUpdateStabilization);
+NEW_PROP_TAG(UseChordNewton);
+NEW_PROP_TAG(ChordContractionRate);
+NEW_PROP_TAG(MaxChordIterations);
+NEW_PROP_TAG(NumLocalDomains);
+NEW_PROP_TAG(MaxLocalSolveIterations);
+NEW_PROP_TAG(LocalToleranceScalingCnv);
 NEW_PROP_TAG(MatrixAddWellContributions);
 NEW_PROP_TAG(EnableWellOperabilityCheck);
 
@@ -71,6 +77,12 @@ SET_INT_PROP(FlowModelParameters, MaxStrictIter, 8);
 SET_BOOL_PROP(FlowModelParameters, SolveWelleqInitially, true);
 SET_BOOL_PROP(FlowModelParameters, UpdateEquationsScaling, false);
 SET_BOOL_PROP(FlowModelParameters, UseUpdateStabilization, true);
+SET_BOOL_PROP(FlowModelParameters, UseChordNewton, false);
+SET_SCALAR_PROP(FlowModelParameters, ChordContractionRate, 0.2);
+SET_INT_PROP(FlowModelParameters, MaxChordIterations, 3);
+SET_INT_PROP(FlowModelParameters, NumLocalDomains, 0);
+SET_INT_PROP(FlowModelParameters, MaxLocalSolveIterations, 20);
+SET_SCALAR_PROP(FlowModelParameters, LocalToleranceScalingCnv, 0.1);
 SET_BOOL_PROP(FlowModelParameters, MatrixAddWellContributions, false);
 SET_SCALAR_PROP(FlowModelParameters, TolerancePressureMsWells, 0.01*1e5);
 SET_SCALAR_PROP(FlowModelParameters, MaxPressureChangeMsWells, 10*1e5);
@@ -142,6 +154,27 @@ namespace Opm
         /// Try to detect oscillation or stagnation.
         bool use_update_stabilization_;
 
+        /// Reuse the Jacobian and the preconditioner of an earlier iteration
+        /// while the Newton method converges fast.
+        bool use_chord_newton_;
+
+        /// Largest reduction of the residuals between two iterations which
+        /// allows a chord iteration.
+        double chord_contraction_rate_;
+
+        /// Maximum number of chord iterations before the Jacobian is updated.
+        int max_chord_iterations_;
+
+        /// Number of subdomains of each process which are solved by local
+        /// Newton iterations before each global iteration, zero to disable.
+        int num_local_domains_;
+
+        /// Maximum number of Newton iterations of a subdomain.
+        int max_local_solve_iterations_;
+
+        /// Factor applied to the CNV tolerance for the local convergence check.
+        double local_tolerance_scaling_cnv_;
+
         /// Whether to use MultisegmentWell to handle multisegment wells
         /// it is something temporary before the multisegment well model is considered to be
         /// well developed and tested.
@@ -177,6 +210,12 @@ namespace Opm
             solve_welleq_initially_ = EWOMS_GET_PARAM(TypeTag, bool, SolveWelleqInitially);
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
+            use_chord_newton_ = EWOMS_GET_PARAM(TypeTag, bool, UseChordNewton);
+            chord_contraction_rate_ = EWOMS_GET_PARAM(TypeTag, Scalar, ChordContractionRate);
+            max_chord_iterations_ = EWOMS_GET_PARAM(TypeTag, int, MaxChordIterations);
+            num_local_domains_ = EWOMS_GET_PARAM(TypeTag, int, NumLocalDomains);
+            max_local_solve_iterations_ = EWOMS_GET_PARAM(TypeTag, int, MaxLocalSolveIterations);
+            local_tolerance_scaling_cnv_ = EWOMS_GET_PARAM(TypeTag, Scalar, LocalToleranceScalingCnv);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
 
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
@@ -203,6 +242,12 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, SolveWelleqInitially, "Fully solve the well equations before each iteration of the reservoir model");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseChordNewton, "Reuse the reservoir Jacobian and the preconditioner of an earlier Newton iteration while the residuals decrease fast enough. Without --matrix-add-well-contributions the well terms of the operator are still those of the current iteration");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, ChordContractionRate, "Largest ratio of the residuals of two consecutive Newton iterations which allows to reuse the Jacobian");
+            EWOMS_REGISTER_PARAM(TypeTag, int, MaxChordIterations, "Maximum number of Newton iterations which reuse the same Jacobian");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NumLocalDomains, "Number of subdomains per process which are solved by local Newton iterations before each global Newton iteration (0: disabled)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, MaxLocalSolveIterations, "Maximum number of Newton iterations of the local solve of a subdomain");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalToleranceScalingCnv, "Factor applied to the CNV tolerance to obtain the convergence tolerance of the local solves");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
         }
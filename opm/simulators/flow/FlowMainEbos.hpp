@@ -54,12 +54,14 @@ NEW_PROP_TAG(EnableDryRun);
 NEW_PROP_TAG(OutputInterval);
 NEW_PROP_TAG(UseAmg);
 NEW_PROP_TAG(EnableLoggingFalloutWarning);
+NEW_PROP_TAG(DeckCacheFile);
 
 // TODO: enumeration parameters. we use strings for now.
 SET_STRING_PROP(EclFlowProblem, EnableDryRun, "auto");
 // Do not merge parallel output files or warn about them
 SET_BOOL_PROP(EclFlowProblem, EnableLoggingFalloutWarning, false);
 SET_INT_PROP(EclFlowProblem, OutputInterval, 1);
+SET_STRING_PROP(EclFlowProblem, DeckCacheFile, "");
 
 END_PROPERTIES
 
@@ -101,6 +103,8 @@ namespace Opm
                                  "Specify the number of report steps between two consecutive writes of restart data");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableLoggingFalloutWarning,
                                  "Developer option to see whether logging was on non-root processors. In that case it will be appended to the *.DBG or *.PRT files");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, DeckCacheFile,
+                                 "Name of a file used to cache the schedule and summary configuration between runs of the same deck. The deck is still parsed and the EclipseState is still created. Empty disables the cache");
 
             Simulator::registerParameters();
 
@@ -256,7 +260,48 @@ namespace Opm
         /// input.
         int execute(int argc, char** argv, bool output_cout, bool output_to_files)
         {
-            try {
+            return execute_(argc, argv, output_cout, output_to_files, &FlowMainEbos::runSimulator);
+        }
+
+        /// Set up the simulation like execute(), but stop before the first report
+        /// step. The report steps are then run one by one by executeStep() and
+        /// the simulation is finished by executeStepsCleanup().
+        int executeInitStep(int argc, char** argv, bool output_cout, bool output_to_files)
+        {
+            return execute_(argc, argv, output_cout, output_to_files, &FlowMainEbos::runSimulatorInit_);
+        }
+
+        /// Run the next report step of a simulation set up by executeInitStep().
+        /// Call this only while hasMoreSteps() is true.
+        int executeStep()
+        {
+            return execute_([this]() { return runSimulatorStep_(); });
+        }
+
+        /// Finish a simulation set up by executeInitStep().
+        int executeStepsCleanup()
+        {
+            return execute_([this]() {
+                int retval = runSimulatorAfterSim_();
+                mergeParallelLogFiles(output_to_files_);
+                return retval;
+            });
+        }
+
+        /// Whether executeStep() has report steps left to run.
+        bool hasMoreSteps() const
+        { return simtimer_ && !simtimer_->done() && !stopped_; }
+
+        EbosSimulator* getSimulatorPtr()
+        { return ebosSimulator_.get(); }
+
+    private:
+        int execute_(int argc, char** argv, bool output_cout, bool output_to_files,
+                     int (FlowMainEbos::* runOrInitFunc)(bool))
+        {
+            output_cout_ = output_cout;
+            output_to_files_ = output_to_files;
+            return execute_([&]() {
                 // deal with some administrative boilerplate
 
                 int status = setupParameters_(argc, argv);
@@ -269,18 +314,27 @@ namespace Opm
                 createSimulator();
 
                 // do the actual work
-                int retval = runSimulator(output_cout);
+                int retval = (this->*runOrInitFunc)(output_cout);
 
                 // clean up
-                mergeParallelLogFiles(output_to_files);
+                if (runOrInitFunc == &FlowMainEbos::runSimulator)
+                    mergeParallelLogFiles(output_to_files);
 
                 return retval;
+            });
+        }
+
+        template <class Func>
+        int execute_(Func&& func)
+        {
+            try {
+                return func();
             }
             catch (const std::exception& e) {
                 std::ostringstream message;
                 message  << "Program threw an exception: " << e.what();
 
-                if (output_cout) {
+                if (output_cout_) {
                     // in some cases exceptions are thrown before the logging system is set
                     // up.
                     if (OpmLog::hasBackend("STREAMLOG")) {
@@ -295,6 +349,7 @@ namespace Opm
             }
         }
 
+    public:
         // Print an ASCII-art header to the PRT and DEBUG files.
         // \return Whether unkown keywords were seen during parsing.
         static void printPRTHeader(bool output_cout)
@@ -475,15 +530,31 @@ namespace Opm
 
         // Run the simulator.
         int runSimulator(bool output_cout)
+        {
+            int retval = runSimulatorInit_(output_cout);
+            if (retval != EXIT_SUCCESS || eclState().getIOConfig().initOnly())
+                return retval;
+
+            while (hasMoreSteps())
+                runSimulatorStep_();
+
+            return runSimulatorAfterSim_();
+        }
+
+        // Prepare the timer and the simulator for running the report steps.
+        // Writes to:
+        //   simtimer_
+        int runSimulatorInit_(bool output_cout)
         {
             const auto& schedule = this->schedule();
             const auto& timeMap = schedule.getTimeMap();
             auto& ioConfig = eclState().getIOConfig();
-            SimulatorTimer simtimer;
+            simtimer_ = std::make_unique<SimulatorTimer>();
+            stopped_ = false;
 
             // initialize variables
             const auto& initConfig = eclState().getInitConfig();
-            simtimer.init(timeMap, (size_t)initConfig.getRestartStep());
+            simtimer_->init(timeMap, (size_t)initConfig.getRestartStep());
 
             if (output_cout) {
                 std::ostringstream oss;
@@ -504,36 +575,54 @@ namespace Opm
                     OpmLog::info(msg);
                 }
 
-                SimulatorReport report = simulator_->run(simtimer);
-                if (output_cout) {
-                    std::ostringstream ss;
-                    ss << "\n\n================    End of simulation     ===============\n\n";
-                    ss << "Number of MPI processes: " << std::setw(6) << mpi_size_ << "\n";
-#if _OPENMP
-                    int threads = omp_get_max_threads();
-#else
-                    int threads = 1;
-#endif
-                    ss << "Threads per MPI process:  " << std::setw(5) << threads << "\n";
-                    report.reportFullyImplicit(ss);
-                    OpmLog::info(ss.str());
-                    const std::string dir = eclState().getIOConfig().getOutputDir();
-                    namespace fs = Opm::filesystem;
-                    fs::path output_dir(dir);
-                    {
-                        std::string filename = eclState().getIOConfig().getBaseName() + ".INFOSTEP";
-                        fs::path fullpath = output_dir / filename;
-                        std::ofstream os(fullpath.string());
-                        report.fullReports(os);
-                    }
-                }
-                return report.success.exit_status;
+                simulator_->init(*simtimer_);
             } else {
+                stopped_ = true;
                 if (output_cout) {
                     std::cout << "\n\n================ Simulation turned off ===============\n" << std::flush;
                 }
+            }
+            return EXIT_SUCCESS;
+        }
+
+        // Run the next report step.
+        int runSimulatorStep_()
+        {
+            if (!simulator_->runStep(*simtimer_))
+                stopped_ = true;
+            return EXIT_SUCCESS;
+        }
+
+        // Finish the simulation and print the final report.
+        int runSimulatorAfterSim_()
+        {
+            if (eclState().getIOConfig().initOnly())
                 return EXIT_SUCCESS;
+
+            SimulatorReport report = simulator_->finalize();
+            if (output_cout_) {
+                std::ostringstream ss;
+                ss << "\n\n================    End of simulation     ===============\n\n";
+                ss << "Number of MPI processes: " << std::setw(6) << mpi_size_ << "\n";
+#if _OPENMP
+                int threads = omp_get_max_threads();
+#else
+                int threads = 1;
+#endif
+                ss << "Threads per MPI process:  " << std::setw(5) << threads << "\n";
+                report.reportFullyImplicit(ss);
+                OpmLog::info(ss.str());
+                const std::string dir = eclState().getIOConfig().getOutputDir();
+                namespace fs = Opm::filesystem;
+                fs::path output_dir(dir);
+                {
+                    std::string filename = eclState().getIOConfig().getBaseName() + ".INFOSTEP";
+                    fs::path fullpath = output_dir / filename;
+                    std::ofstream os(fullpath.string());
+                    report.fullReports(os);
+                }
             }
+            return report.success.exit_status;
         }
 
         /// This is the main function of Flow.
@@ -563,6 +652,10 @@ namespace Opm
         int  mpi_size_ = 1;
         std::any parallel_information_;
         std::unique_ptr<Simulator> simulator_;
+        std::unique_ptr<SimulatorTimer> simtimer_;
+        bool stopped_ = false;
+        bool output_cout_ = false;
+        bool output_to_files_ = false;
     };
 } // namespace Opm
 
@@ -62,8 +62,12 @@
 #if HAVE_MPI
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
+#include <opm/simulators/utils/DeckCache.hpp>
 #endif
 
+#include <algorithm>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <type_traits>
 
@@ -163,6 +167,13 @@ namespace Opm
             }
         }
 
+        /// Set up a blackoil simulation without running it. The report steps are
+        /// run by the executeStep() method of the returned object, this is used
+        /// by the Python bindings. Returns nullptr if the setup failed, the exit
+        /// code is then set. Defined in flow/flow_ebos_blackoil.cpp, such that the
+        /// simulator is only instantiated in that translation unit.
+        std::unique_ptr<Opm::FlowMainEbos<TTAG(EclFlowProblem)>> initFlowEbosBlackoil(int& exitCode);
+
         template <class TypeTag>
         int runStatic()
         {
@@ -374,12 +385,19 @@ namespace Opm
                     Opm::FlowMainEbos<PreTypeTag>::printPRTHeader(outputCout_);
 
                     if (mpiRank == 0) {
+                        // the deck cache only covers the schedule and summary config,
+                        // so the time of each setup phase is logged to show how much
+                        // of the input setup it can save.
+                        Dune::Timer inputPhaseTimer;
+                        inputPhaseTimer.start();
                         if (!deck_)
                             deck_.reset( new Opm::Deck( parser.parseFile(deckFilename , parseContext, errorGuard)));
                         Opm::MissingFeatures::checkKeywords(*deck_, parseContext, errorGuard);
                         if ( outputCout_ )
                             Opm::checkDeck(*deck_, parser, parseContext, errorGuard);
+                        const double parseTime = inputPhaseTimer.elapsed();
 
+                        inputPhaseTimer.reset();
                         if (!eclipseState_) {
 #if HAVE_MPI
                             eclipseState_.reset(new Opm::ParallelEclipseState(*deck_));
@@ -387,6 +405,8 @@ namespace Opm
                             eclipseState_.reset(new Opm::EclipseState(*deck_));
 #endif
                         }
+                        const double eclipseStateTime = inputPhaseTimer.elapsed();
+                        inputPhaseTimer.reset();
                         /*
                           For the time being initializing wells and groups from the
                           restart file is not possible, but work is underways and it is
@@ -394,7 +414,28 @@ namespace Opm
                         */
                         const bool init_from_restart_file = !EWOMS_GET_PARAM(PreTypeTag, bool, SchedRestart);
                         const auto& init_config = eclipseState_->getInitConfig();
-                        if (init_config.restartRequested() && init_from_restart_file) {
+                        const bool useRestartSchedule = init_config.restartRequested() && init_from_restart_file;
+
+#if HAVE_MPI
+                        // the schedule and summary config can optionally be taken from
+                        // a cache written by a previous run of an identical deck.
+                        std::string deckCacheFile = EWOMS_GET_PARAM(PreTypeTag, std::string, DeckCacheFile);
+                        std::string deckCacheKey;
+                        bool loadedFromCache = false;
+                        if (!deckCacheFile.empty() && !useRestartSchedule && !schedule_ && !summaryConfig_) {
+                            deckCacheKey = Opm::deckCacheKey(deckFilename, parseContext);
+                            if (deckCacheKey.empty()) {
+                                OpmLog::warning("deck_cache_disabled", "Deck cache disabled: the deck refers to files which could not be resolved");
+                            }
+                            else
+                                loadedFromCache = loadScheduleFromCache_(deckCacheFile, deckCacheKey, python);
+                        }
+#endif
+
+                        Dune::Timer scheduleSetupTimer;
+                        scheduleSetupTimer.start();
+                        const bool createSchedule = !schedule_;
+                        if (useRestartSchedule) {
                             int report_step = init_config.getRestartStep();
                             const auto& rst_filename = eclipseState_->getIOConfig().getRestartFileName( init_config.getRestartRootName(), report_step, false );
                             Opm::EclIO::ERst rst_file(rst_filename);
@@ -409,6 +450,33 @@ namespace Opm
                         setupMessageLimiter_(schedule_->getMessageLimits(), "STDOUT_LOGGER");
                         if (!summaryConfig_)
                             summaryConfig_.reset( new Opm::SummaryConfig(*deck_, *schedule_, eclipseState_->getTableManager(), parseContext, errorGuard));
+                        const double scheduleTime = inputPhaseTimer.elapsed();
+
+                        std::ostringstream phaseMessage;
+                        phaseMessage << "Input setup: parsing " << parseTime << " seconds, EclipseState "
+                                     << eclipseStateTime << " seconds, schedule and summary configuration "
+                                     << scheduleTime << " seconds";
+#if HAVE_MPI
+                        if (loadedFromCache)
+                            phaseMessage << " (loaded from deck cache)";
+#endif
+                        OpmLog::info(phaseMessage.str());
+
+#if HAVE_MPI
+                        if (!deckCacheKey.empty() && createSchedule && !errorGuard) {
+                            // the cache is optional, failing to write it must not stop the run
+                            try {
+                                Opm::writeDeckCache(deckCacheFile, deckCacheKey, *schedule_, *summaryConfig_,
+                                                    scheduleSetupTimer.elapsed());
+                                OpmLog::info("Wrote schedule and summary configuration to deck cache '" + deckCacheFile + "'");
+                            }
+                            catch (const std::exception& e) {
+                                OpmLog::warning("deck_cache_write", std::string("Could not write deck cache: ") + e.what());
+                            }
+                        }
+#else
+                        (void) createSchedule;
+#endif
                     }
 #if HAVE_MPI
                     else {
@@ -448,6 +516,38 @@ namespace Opm
             return true;
         }
 
+#if HAVE_MPI
+        // Load the schedule and summary configuration from the deck cache. If the
+        // cache does not exist or was written for a different deck, the objects are
+        // left untouched and false is returned.
+        bool loadScheduleFromCache_(const std::string& deckCacheFile,
+                                    const std::string& deckCacheKey,
+                                    std::shared_ptr<Opm::Python> python)
+        {
+            Dune::Timer cacheTimer;
+            cacheTimer.start();
+
+            auto schedule = std::make_unique<Opm::Schedule>(python);
+            auto summaryConfig = std::make_unique<Opm::SummaryConfig>();
+            double cachedSetupTime = 0.0;
+            if (!Opm::loadDeckCache(deckCacheFile, deckCacheKey, *schedule, *summaryConfig, cachedSetupTime)) {
+                OpmLog::info("Deck cache '" + deckCacheFile + "' is missing or outdated");
+                return false;
+            }
+
+            schedule_ = std::move(schedule);
+            summaryConfig_ = std::move(summaryConfig);
+
+            const double loadTime = cacheTimer.elapsed();
+            std::ostringstream message;
+            message << "Loaded schedule and summary configuration from deck cache '"
+                    << deckCacheFile << "' in " << loadTime << " seconds ("
+                    << std::max(cachedSetupTime - loadTime, 0.0) << " seconds saved)";
+            OpmLog::info(message.str());
+            return true;
+        }
+#endif
+
         Opm::filesystem::path simulationCaseName_( const std::string& casename ) {
             namespace fs = Opm::filesystem;
 
@@ -27,6 +27,7 @@
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
 #include <opm/simulators/wells/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
@@ -39,10 +40,14 @@ BEGIN_PROPERTIES
 NEW_PROP_TAG(EnableTerminalOutput);
 NEW_PROP_TAG(EnableAdaptiveTimeStepping);
 NEW_PROP_TAG(EnableTuning);
+NEW_PROP_TAG(LoadImbalanceThreshold);
+NEW_PROP_TAG(EnableMemoryReport);
 
 SET_BOOL_PROP(EclFlowProblem, EnableTerminalOutput, true);
 SET_BOOL_PROP(EclFlowProblem, EnableAdaptiveTimeStepping, true);
 SET_BOOL_PROP(EclFlowProblem, EnableTuning, false);
+SET_SCALAR_PROP(EclFlowProblem, LoadImbalanceThreshold, 1.5);
+SET_BOOL_PROP(EclFlowProblem, EnableMemoryReport, false);
 
 END_PROPERTIES
 
@@ -55,6 +60,7 @@ class SimulatorFullyImplicitBlackoilEbos
 {
 public:
     typedef typename GET_PROP_TYPE(TypeTag, Simulator) Simulator;
+    typedef typename GET_PROP_TYPE(TypeTag, Scalar) Scalar;
     typedef typename GET_PROP_TYPE(TypeTag, Grid) Grid;
     typedef typename GET_PROP_TYPE(TypeTag, FluidSystem) FluidSystem;
     typedef typename GET_PROP_TYPE(TypeTag, ElementContext) ElementContext;
@@ -120,6 +126,10 @@ public:
                              "Use adaptive time stepping between report steps");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTuning,
                              "Honor some aspects of the TUNING keyword.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, LoadImbalanceThreshold,
+                             "Ratio between the maximum and the average per-process number of Jacobian nonzeros above which a load imbalance warning is issued");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableMemoryReport,
+                             "Print the memory used by the grid, the linear system, the well model and the output buffers at startup and after each report step");
     }
 
     /// Run the simulation.
@@ -129,170 +139,210 @@ public:
     /// \param[in,out] state       state of reservoir: pressure, fluxes
     /// \return                    simulation report, with timing data
     SimulatorReport run(SimulatorTimer& timer)
+    {
+        init(timer);
+        // Main simulation loop.
+        while (!timer.done()) {
+            if (!runStep(timer))
+                break;
+        }
+        return finalize();
+    }
+
+    /// Prepare the simulation of the report steps governed by the timer.
+    /// Together with runStep() and finalize() this allows to advance the
+    /// simulation one report step at a time, run() is equivalent to calling
+    /// init(), runStep() until the timer is done and finalize().
+    void init(SimulatorTimer& timer)
     {
         ebosSimulator_.setEpisodeIndex(-1);
 
         // Create timers and file for writing timing info.
-        Opm::time::StopWatch solverTimer;
-        Opm::time::StopWatch totalTimer;
-        totalTimer.start();
+        solverTimer_.reset(new Opm::time::StopWatch());
+        totalTimer_.reset(new Opm::time::StopWatch());
+        totalTimer_->start();
 
         // adaptive time stepping
-        const auto& events = schedule().getEvents();
-        std::unique_ptr<TimeStepper > adaptiveTimeStepping;
         bool enableAdaptive = EWOMS_GET_PARAM(TypeTag, bool, EnableAdaptiveTimeStepping);
         bool enableTUNING = EWOMS_GET_PARAM(TypeTag, bool, EnableTuning);
         if (enableAdaptive) {
             if (enableTUNING) {
-                adaptiveTimeStepping.reset(new TimeStepper(schedule().getTuning(timer.currentStepNum()), terminalOutput_));
+                adaptiveTimeStepping_.reset(new TimeStepper(schedule().getTuning(timer.currentStepNum()), terminalOutput_));
             }
             else {
-                adaptiveTimeStepping.reset(new TimeStepper(terminalOutput_));
+                adaptiveTimeStepping_.reset(new TimeStepper(terminalOutput_));
             }
 
             if (isRestart()) {
                 // For restarts the ebosSimulator may have gotten some information
                 // about the next timestep size from the OPMEXTRA field
-                adaptiveTimeStepping->setSuggestedNextStep(ebosSimulator_.timeStepSize());
+                adaptiveTimeStepping_->setSuggestedNextStep(ebosSimulator_.timeStepSize());
             }
         }
 
-        SimulatorReport report;
+        report_ = SimulatorReport();
+        workImbalanceReported_ = false;
 
-        // Main simulation loop.
-        while (!timer.done()) {
-            if (schedule().exitStatus().has_value()) {
-                if (terminalOutput_) {
-                    OpmLog::info("Stopping simulation since EXIT was triggered by an action keyword.");
-                }
-                report.success.exit_status = schedule().exitStatus().value();
-                break;
-            }
+        // the linear system is only allocated by the first linearization
+        reportMemoryUsage_("Memory usage at startup", /*withLinearSystem=*/false);
+    }
 
-            // Report timestep.
+    /// Run the current report step of the timer and advance the timer.
+    /// \return false if the simulation was stopped by an EXIT keyword
+    bool runStep(SimulatorTimer& timer)
+    {
+        if (schedule().exitStatus().has_value()) {
             if (terminalOutput_) {
-                std::ostringstream ss;
-                timer.report(ss);
-                OpmLog::debug(ss.str());
+                OpmLog::info("Stopping simulation since EXIT was triggered by an action keyword.");
             }
+            report_.success.exit_status = schedule().exitStatus().value();
+            return false;
+        }
 
-            if (terminalOutput_) {
-                std::ostringstream stepMsg;
-                boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
-                stepMsg.imbue(std::locale(std::locale::classic(), facet));
-                stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
-                         << "/" << timer.numSteps()
-                         << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
-                         << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
-                         << ", date = " << timer.currentDateTime();
-                OpmLog::info(stepMsg.str());
-            }
+        // Report timestep.
+        if (terminalOutput_) {
+            std::ostringstream ss;
+            timer.report(ss);
+            OpmLog::debug(ss.str());
+        }
 
-            // write the inital state at the report stage
-            if (timer.initialStep()) {
-                Dune::Timer perfTimer;
-                perfTimer.start();
+        if (terminalOutput_) {
+            std::ostringstream stepMsg;
+            boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
+            stepMsg.imbue(std::locale(std::locale::classic(), facet));
+            stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
+                     << "/" << timer.numSteps()
+                     << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
+                     << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
+                     << ", date = " << timer.currentDateTime();
+            OpmLog::info(stepMsg.str());
+        }
 
-                ebosSimulator_.setEpisodeIndex(-1);
-                ebosSimulator_.setEpisodeLength(0.0);
-                ebosSimulator_.setTimeStepSize(0.0);
+        // write the inital state at the report stage
+        if (timer.initialStep()) {
+            Dune::Timer perfTimer;
+            perfTimer.start();
 
-                wellModel_().beginReportStep(timer.currentStepNum());
-                ebosSimulator_.problem().writeOutput();
+            ebosSimulator_.setEpisodeIndex(-1);
+            ebosSimulator_.setEpisodeLength(0.0);
+            ebosSimulator_.setTimeStepSize(0.0);
 
-                report.success.output_write_time += perfTimer.stop();
-            }
+            wellModel_().beginReportStep(timer.currentStepNum());
+            ebosSimulator_.problem().writeOutput();
 
-            // Run a multiple steps of the solver depending on the time step control.
-            solverTimer.start();
-
-            auto solver = createSolver(wellModel_());
-
-            ebosSimulator_.startNextEpisode(ebosSimulator_.startTime() + schedule().getTimeMap().getTimePassedUntil(timer.currentStepNum()),
-                                            timer.currentStepLength());
-            ebosSimulator_.setEpisodeIndex(timer.currentStepNum());
-            solver->model().beginReportStep();
-
-            // If sub stepping is enabled allow the solver to sub cycle
-            // in case the report steps are too large for the solver to converge
-            //
-            // \Note: The report steps are met in any case
-            // \Note: The sub stepping will require a copy of the state variables
-            if (adaptiveTimeStepping) {
-                if (enableTUNING) {
-                    if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
-                        adaptiveTimeStepping->updateTUNING(schedule().getTuning(timer.currentStepNum()));
-                    }
-                }
+            report_.success.output_write_time += perfTimer.stop();
+        }
 
-                bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
-                auto stepReport = adaptiveTimeStepping->step(timer, *solver, event, nullptr);
-                report += stepReport;
-            } else {
-                // solve for complete report step
-                auto stepReport = solver->step(timer);
-                report += stepReport;
-                if (terminalOutput_) {
-                    std::ostringstream ss;
-                    stepReport.reportStep(ss);
-                    OpmLog::info(ss.str());
+        // Run a multiple steps of the solver depending on the time step control.
+        solverTimer_->start();
+        const double assembleTimeBefore = report_.success.assemble_time + report_.failure.assemble_time;
+        const double linearSolveTimeBefore = report_.success.linear_solve_time + report_.failure.linear_solve_time;
+
+        auto solver = createSolver(wellModel_());
+
+        ebosSimulator_.startNextEpisode(ebosSimulator_.startTime() + schedule().getTimeMap().getTimePassedUntil(timer.currentStepNum()),
+                                        timer.currentStepLength());
+        ebosSimulator_.setEpisodeIndex(timer.currentStepNum());
+        solver->model().beginReportStep();
+
+        // If sub stepping is enabled allow the solver to sub cycle
+        // in case the report steps are too large for the solver to converge
+        //
+        // \Note: The report steps are met in any case
+        // \Note: The sub stepping will require a copy of the state variables
+        if (adaptiveTimeStepping_) {
+            const auto& events = schedule().getEvents();
+            bool enableTUNING = EWOMS_GET_PARAM(TypeTag, bool, EnableTuning);
+            if (enableTUNING) {
+                if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
+                    adaptiveTimeStepping_->updateTUNING(schedule().getTuning(timer.currentStepNum()));
                 }
             }
 
-            // write simulation state at the report stage
-            Dune::Timer perfTimer;
-            perfTimer.start();
-            const double nextstep = adaptiveTimeStepping ? adaptiveTimeStepping->suggestedNextStep() : -1.0;
-            ebosSimulator_.problem().setNextTimeStepSize(nextstep);
-            ebosSimulator_.problem().writeOutput();
-            report.success.output_write_time += perfTimer.stop();
+            bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
+            auto stepReport = adaptiveTimeStepping_->step(timer, *solver, event, nullptr);
+            report_ += stepReport;
+        } else {
+            // solve for complete report step
+            auto stepReport = solver->step(timer);
+            report_ += stepReport;
+            if (terminalOutput_) {
+                std::ostringstream ss;
+                stepReport.reportStep(ss);
+                OpmLog::info(ss.str());
+            }
+        }
 
-            solver->model().endReportStep();
+        // write simulation state at the report stage
+        Dune::Timer perfTimer;
+        perfTimer.start();
+        const double nextstep = adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0;
+        ebosSimulator_.problem().setNextTimeStepSize(nextstep);
+        ebosSimulator_.problem().writeOutput();
+        report_.success.output_write_time += perfTimer.stop();
 
-            // take time that was used to solve system for this reportStep
-            solverTimer.stop();
+        solver->model().endReportStep();
 
-            // update timing.
-            report.success.solver_time += solverTimer.secsSinceStart();
+        // take time that was used to solve system for this reportStep
+        solverTimer_->stop();
 
-            // Increment timer, remember well state.
-            ++timer;
+        // the Jacobian is only allocated by the first linearization, so the work
+        // of the processes is compared after the first report step
+        if (!workImbalanceReported_) {
+            reportWorkImbalance_();
+            workImbalanceReported_ = true;
+        }
+        reportTimeImbalance_(report_.success.assemble_time + report_.failure.assemble_time - assembleTimeBefore,
+                             report_.success.linear_solve_time + report_.failure.linear_solve_time - linearSolveTimeBefore);
+        reportMemoryUsage_("Memory usage after report step " + std::to_string(timer.currentStepNum()),
+                           /*withLinearSystem=*/true);
 
+        // update timing.
+        report_.success.solver_time += solverTimer_->secsSinceStart();
 
-            if (terminalOutput_) {
-                if (!timer.initialStep()) {
-                    const std::string version = moduleVersionName();
-                    outputTimestampFIP(timer, version);
-                }
-            }
+        // Increment timer, remember well state.
+        ++timer;
 
-            if (terminalOutput_) {
-                std::string msg =
-                    "Time step took " + std::to_string(solverTimer.secsSinceStart()) + " seconds; "
-                    "total solver time " + std::to_string(report.success.solver_time) + " seconds.";
-                OpmLog::debug(msg);
+
+        if (terminalOutput_) {
+            if (!timer.initialStep()) {
+                const std::string version = moduleVersionName();
+                outputTimestampFIP(timer, version);
             }
+        }
 
+        if (terminalOutput_) {
+            std::string msg =
+                "Time step took " + std::to_string(solverTimer_->secsSinceStart()) + " seconds; "
+                "total solver time " + std::to_string(report_.success.solver_time) + " seconds.";
+            OpmLog::debug(msg);
         }
 
+        return true;
+    }
+
+    /// Write the remaining output and return the report of the report steps
+    /// run since init().
+    SimulatorReport finalize()
+    {
         // make sure all output is written to disk before run is finished
         {
             Dune::Timer finalOutputTimer;
             finalOutputTimer.start();
 
             ebosSimulator_.problem().finalizeOutput();
-            report.success.output_write_time += finalOutputTimer.stop();
+            report_.success.output_write_time += finalOutputTimer.stop();
         }
 
         // Stop timer and create timing report
-        totalTimer.stop();
-        report.success.total_time = totalTimer.secsSinceStart();
-        report.success.converged = true;
+        totalTimer_->stop();
+        report_.success.total_time = totalTimer_->secsSinceStart();
+        report_.success.converged = true;
 
-        return report;
+        return report_;
     }
 
     const Grid& grid() const
@@ -310,6 +360,130 @@ protected:
         return std::unique_ptr<Solver>(new Solver(solverParam_, std::move(model)));
     }
 
+    /// Report how unevenly the work is distributed over the processes.
+    ///
+    /// The work of a process is measured by what it owns, i.e., its interior
+    /// cells, the nonzero blocks of their rows of the Jacobian and its well
+    /// perforations. These only change with the partitioning, so they are
+    /// reported once. The imbalance of a quantity is the ratio between its
+    /// maximum and its average over all processes, i.e., 1.0 means perfect
+    /// balance. A warning is issued if the imbalance of the nonzeros exceeds
+    /// the LoadImbalanceThreshold parameter.
+    void reportWorkImbalance_()
+    {
+        const auto& comm = grid().comm();
+        if (comm.size() < 2)
+            return;
+
+        const auto& ebosModel = ebosSimulator_.model();
+        const auto& jacobian = ebosModel.linearizer().jacobian().istlMatrix();
+        const auto& elemMapper = ebosModel.elementMapper();
+        const auto& gridView = ebosSimulator_.gridView();
+        double cells = 0.0;
+        double nonzeros = 0.0;
+        const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+        for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+             elemIt != elemEndIt;
+             ++elemIt)
+        {
+            cells += 1.0;
+            nonzeros += jacobian[elemMapper.index(*elemIt)].size();
+        }
+        const double perforations = wellModel_().wellState().perfPress().size();
+
+        double maxCounts[3] = { cells, nonzeros, perforations };
+        double sumCounts[3] = { cells, nonzeros, perforations };
+        comm.max(maxCounts, 3);
+        comm.sum(sumCounts, 3);
+
+        const auto imbalance = [&comm](double maxCount, double sumCount) {
+            const double avgCount = sumCount/comm.size();
+            return avgCount > 0.0 ? maxCount/avgCount : 1.0;
+        };
+
+        const double cellImbalance = imbalance(maxCounts[0], sumCounts[0]);
+        const double nonzeroImbalance = imbalance(maxCounts[1], sumCounts[1]);
+        const double perforationImbalance = imbalance(maxCounts[2], sumCounts[2]);
+
+        if (terminalOutput_) {
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << "Load imbalance (max/avg): cells " << cellImbalance
+               << ", Jacobian nonzeros " << nonzeroImbalance
+               << ", well perforations " << perforationImbalance;
+            OpmLog::info(ss.str());
+
+            const Scalar threshold = EWOMS_GET_PARAM(TypeTag, Scalar, LoadImbalanceThreshold);
+            if (threshold > 1.0 && nonzeroImbalance > threshold) {
+                std::ostringstream warn;
+                warn << std::fixed << std::setprecision(2)
+                     << "Load imbalance of " << nonzeroImbalance << " exceeds threshold of " << threshold
+                     << " (largest process " << std::setprecision(0) << maxCounts[1]
+                     << " Jacobian nonzeros, average " << sumCounts[1]/comm.size() << "). "
+                     << "Consider a different partitioning (e.g. --edge-weights-method).";
+                OpmLog::warning("load_imbalance", warn.str());
+            }
+        }
+    }
+
+    /// Report how unevenly the assembly and linear solve times of the last
+    /// report step are distributed over the processes, as the ratio between
+    /// the maximum and the average time.
+    ///
+    /// The times include the waiting of a process in collective operations for
+    /// slower ones, in particular in the linear solver, so they understate the
+    /// imbalance. Its change over the report steps shows how the imbalance
+    /// develops, e.g. when wells are opened.
+    void reportTimeImbalance_(double assembleTime, double linearSolveTime)
+    {
+        const auto& comm = grid().comm();
+        if (comm.size() < 2)
+            return;
+
+        double maxTimes[2] = { assembleTime, linearSolveTime };
+        double sumTimes[2] = { assembleTime, linearSolveTime };
+        comm.max(maxTimes, 2);
+        comm.sum(sumTimes, 2);
+
+        if (terminalOutput_) {
+            const auto imbalance = [&comm](double maxTime, double sumTime) {
+                const double avgTime = sumTime/comm.size();
+                return avgTime > 0.0 ? maxTime/avgTime : 1.0;
+            };
+
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << "Time imbalance of report step (max/avg): assembly " << imbalance(maxTimes[0], sumTimes[0])
+               << " (max " << maxTimes[0] << " sec), linear solve " << imbalance(maxTimes[1], sumTimes[1])
+               << " (max " << maxTimes[1] << " sec)";
+            OpmLog::info(ss.str());
+        }
+    }
+
+    /// Print the memory used by the subsystems of the simulator, summed over
+    /// all processes and the maximum of a single process, if the
+    /// EnableMemoryReport parameter is set.
+    void reportMemoryUsage_(const std::string& title, bool withLinearSystem)
+    {
+        if (!EWOMS_GET_PARAM(TypeTag, bool, EnableMemoryReport))
+            return;
+
+        MemoryReport report;
+        ebosSimulator_.problem().addMemoryUsage(report);
+        if (withLinearSystem) {
+            auto& ebosModel = ebosSimulator_.model();
+            const auto& linearizer = ebosModel.linearizer();
+            report.add("Jacobian", matrixMemoryUsage(linearizer.jacobian().istlMatrix())
+                       + linearizer.residual().size() * sizeof(linearizer.residual()[0]));
+            ebosModel.newtonMethod().linearSolver().addMemoryUsage(report);
+        }
+        report.add("Well model", wellModel_().memoryUsage());
+
+        report.reduce(grid().comm());
+        if (terminalOutput_)
+            OpmLog::info(report.str(title));
+    }
+
     void outputTimestampFIP(const SimulatorTimer& timer, const std::string version)
     {
         std::ostringstream ss;
@@ -354,6 +528,13 @@ protected:
     PhaseUsage phaseUsage_;
     // Misc. data
     bool terminalOutput_;
+
+    // State of the report steps run since init()
+    SimulatorReport report_;
+    bool workImbalanceReported_ = false;
+    std::unique_ptr<Opm::time::StopWatch> solverTimer_;
+    std::unique_ptr<Opm::time::StopWatch> totalTimer_;
+    std::unique_ptr<TimeStepper> adaptiveTimeStepping_;
 };
 
 } // namespace Opm
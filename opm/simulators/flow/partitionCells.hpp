@@ -0,0 +1,84 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PARTITION_CELLS_HPP
+#define OPM_PARTITION_CELLS_HPP
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace Opm {
+
+/*! \brief Splits the cells into domains of nearly equal size by growing each
+ *!        domain breadth first from a seed cell.
+ *! \details The seed of a domain is the unassigned cell with the lowest
+ *!          index. If the cells reachable from the seed are exhausted before
+ *!          the domain is full, growing continues from the next unassigned
+ *!          cell, so a domain may consist of several connected pieces.
+ *! \param numDomains    Requested number of domains, at most one per cell.
+ *! \param neighborStart The neighbors of cell i are neighbors[neighborStart[i]]
+ *!                      ... neighbors[neighborStart[i+1] - 1].
+ *! \param neighbors     The neighbor lists of all cells.
+ *! \return The zero-based domain of each cell.
+*/
+inline std::vector<int> partitionCells(int numDomains,
+                                       const std::vector<int>& neighborStart,
+                                       const std::vector<int>& neighbors)
+{
+    const int numCells = neighborStart.empty() ? 0 : neighborStart.size() - 1;
+    std::vector<int> domain(numCells, -1);
+    numDomains = std::max(1, std::min(numDomains, numCells));
+
+    int nextSeed = 0;
+    std::deque<int> front;
+    for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+        // distribute the remainder of the division over the first domains
+        const int domainSize = numCells/numDomains + (domainIdx < numCells % numDomains ? 1 : 0);
+        int size = 0;
+        front.clear();
+        while (size < domainSize) {
+            if (front.empty()) {
+                while (domain[nextSeed] >= 0)
+                    ++nextSeed;
+                domain[nextSeed] = domainIdx;
+                front.push_back(nextSeed);
+                ++size;
+                continue;
+            }
+
+            const int cellIdx = front.front();
+            front.pop_front();
+            for (int i = neighborStart[cellIdx]; i < neighborStart[cellIdx + 1] && size < domainSize; ++i) {
+                const int neighborIdx = neighbors[i];
+                if (domain[neighborIdx] >= 0)
+                    continue;
+
+                domain[neighborIdx] = domainIdx;
+                front.push_back(neighborIdx);
+                ++size;
+            }
+        }
+    }
+
+    return domain;
+}
+
+} // end namespace Opm
+
+#endif // OPM_PARTITION_CELLS_HPP
@@ -0,0 +1,55 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_AMG_ACCUMULATION_HEADER_INCLUDED
+#define OPM_AMG_ACCUMULATION_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <dune/istl/paamg/parameters.hh>
+
+#include <stdexcept>
+#include <string>
+
+namespace Opm
+{
+
+/// \brief Converts the name of the agglomeration of the AMG coarse levels.
+///
+/// With "none" the coarse levels stay on all processes. With "atonce" a
+/// level is gathered on a single process as soon as the processes hold less
+/// than the coarsen target rows on average, and the coarsest level is then
+/// solved directly. With "successive" the levels are gathered onto fewer
+/// processes step by step. Gathering onto more than one process needs
+/// dune-istl to be built with ParMETIS or PT-Scotch.
+inline Dune::Amg::AccumulationMode convertString2Accumulation(const std::string& accumulation)
+{
+    if (accumulation == "none")
+        return Dune::Amg::noAccu;
+    if (accumulation == "atonce")
+        return Dune::Amg::atOnceAccu;
+    if (accumulation == "successive")
+        return Dune::Amg::successiveAccu;
+
+    OPM_THROW(std::invalid_argument, accumulation << " is not a valid AMG accumulation."
+              << " Please use none, atonce or successive");
+}
+
+} // namespace Opm
+
+#endif // OPM_AMG_ACCUMULATION_HEADER_INCLUDED
@@ -202,13 +202,16 @@ createAMGPreconditionerPointer(Op& opA, const double relax, const P& comm,
         verbosity = params.cpr_solver_verbose_;
     }
     // TODO: revise choice of parameters
-    int coarsenTarget=1200;
+    int coarsenTarget = params.cpr_coarsen_target_;
     using Criterion = C;
     Criterion criterion(15, coarsenTarget);
     criterion.setDebugLevel( verbosity ); // no debug information, 1 for printing hierarchy information
     criterion.setDefaultValuesIsotropic(2);
     criterion.setNoPostSmoothSteps( 1 );
     criterion.setNoPreSmoothSteps( 1 );
+    // gather the coarse levels onto fewer processes instead of leaving
+    // only a few rows on each of them
+    criterion.setAccumulate( params.cpr_accumulate_ );
 
     // Since DUNE 2.2 we also need to pass the smoother args instead of steps directly
     typedef typename AMG::Smoother Smoother;
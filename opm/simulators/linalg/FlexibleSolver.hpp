@@ -22,6 +22,7 @@
 #define OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
@@ -143,7 +144,28 @@ private:
         scalarproduct_ = std::make_shared<Dune::SeqScalarProduct<VectorType>>();
     }
 
-    void initSolver(const boost::property_tree::ptree& prm)
+#if HAVE_MPI
+    // The pipelined BiCGSTAB sums its dot products itself, hence it needs
+    // to know which entries are owned and the communicator.
+    template <class Comm>
+    AbstractSolverType* makePipelinedBiCGSTAB(double tol, int maxiter, int verbosity, const Comm& comm)
+    {
+        return new Opm::PipelinedBiCGSTABSolver<VectorType>(*linearoperator_, *preconditioner_,
+                                                            tol, maxiter, verbosity,
+                                                            Opm::makeOwnerMask(comm, linearoperator_->getmat().N()),
+                                                            comm.communicator());
+    }
+#endif
+
+    AbstractSolverType* makePipelinedBiCGSTAB(double tol, int maxiter, int verbosity,
+                                              const Dune::Amg::SequentialInformation&)
+    {
+        return new Opm::PipelinedBiCGSTABSolver<VectorType>(*linearoperator_, *preconditioner_,
+                                                            tol, maxiter, verbosity);
+    }
+
+    template <class Comm>
+    void initSolver(const boost::property_tree::ptree& prm, const Comm& comm)
     {
         const double tol = prm.get<double>("tol", 1e-2);
         const int maxiter = prm.get<int>("maxiter", 200);
@@ -156,6 +178,8 @@ private:
                                                                   tol, // desired residual reduction factor
                                                                   maxiter, // maximum number of iterations
                                                                   verbosity));
+        } else if (solver_type == "pipelinedbicgstab") {
+            linsolver_.reset(makePipelinedBiCGSTAB(tol, maxiter, verbosity, comm));
         } else if (solver_type == "loopsolver") {
             linsolver_.reset(new Dune::LoopSolver<VectorType>(*linearoperator_,
                                                               *scalarproduct_,
@@ -190,7 +214,7 @@ private:
               const std::function<VectorTypeT()> weightsCalculator, const Comm& comm)
     {
         initOpPrecSp(matrix, prm, weightsCalculator, comm);
-        initSolver(prm);
+        initSolver(prm, comm);
     }
 
     std::shared_ptr<AbstractOperatorType> linearoperator_;
@@ -25,6 +25,7 @@
 #define OPM_FLOWLINEARSOLVERPARAMETERS_HEADER_INCLUDED
 
 #include <opm/common/utility/parameters/ParameterGroup.hpp>
+#include <opm/simulators/linalg/AmgAccumulation.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 
 #include <opm/models/utils/parametersystem.hh>
@@ -53,6 +54,7 @@ NEW_PROP_TAG(MiluVariant);
 NEW_PROP_TAG(IluRedblack);
 NEW_PROP_TAG(IluReorderSpheres);
 NEW_PROP_TAG(UseGmres);
+NEW_PROP_TAG(UsePipelinedBicgstab);
 NEW_PROP_TAG(LinearSolverRequireFullSparsityPattern);
 NEW_PROP_TAG(LinearSolverIgnoreConvergenceFailure);
 NEW_PROP_TAG(UseAmg);
@@ -66,9 +68,12 @@ NEW_PROP_TAG(CprUseDrs);
 NEW_PROP_TAG(CprMaxEllIter);
 NEW_PROP_TAG(CprEllSolvetype);
 NEW_PROP_TAG(CprReuseSetup);
+NEW_PROP_TAG(CprCoarsenTarget);
+NEW_PROP_TAG(CprAccumulate);
 NEW_PROP_TAG(LinearSolverConfiguration);
 NEW_PROP_TAG(LinearSolverConfigurationJsonFile);
 NEW_PROP_TAG(UseGpu);
+NEW_PROP_TAG(LinearSolverOverlapCommunication);
 
 SET_SCALAR_PROP(FlowIstlSolverParams, LinearSolverReduction, 1e-2);
 SET_SCALAR_PROP(FlowIstlSolverParams, IluRelaxation, 0.9);
@@ -80,6 +85,7 @@ SET_STRING_PROP(FlowIstlSolverParams, MiluVariant, "ILU");
 SET_BOOL_PROP(FlowIstlSolverParams, IluRedblack, false);
 SET_BOOL_PROP(FlowIstlSolverParams, IluReorderSpheres, false);
 SET_BOOL_PROP(FlowIstlSolverParams, UseGmres, false);
+SET_BOOL_PROP(FlowIstlSolverParams, UsePipelinedBicgstab, false);
 SET_BOOL_PROP(FlowIstlSolverParams, LinearSolverRequireFullSparsityPattern, false);
 SET_BOOL_PROP(FlowIstlSolverParams, LinearSolverIgnoreConvergenceFailure, false);
 SET_BOOL_PROP(FlowIstlSolverParams, UseAmg, false);
@@ -93,9 +99,12 @@ SET_BOOL_PROP(FlowIstlSolverParams, CprUseDrs, false);
 SET_INT_PROP(FlowIstlSolverParams, CprMaxEllIter, 20);
 SET_INT_PROP(FlowIstlSolverParams, CprEllSolvetype, 0);
 SET_INT_PROP(FlowIstlSolverParams, CprReuseSetup, 0);
+SET_INT_PROP(FlowIstlSolverParams, CprCoarsenTarget, 1200);
+SET_STRING_PROP(FlowIstlSolverParams, CprAccumulate, "none");
 SET_STRING_PROP(FlowIstlSolverParams, LinearSolverConfiguration, "ilu0");
 SET_STRING_PROP(FlowIstlSolverParams, LinearSolverConfigurationJsonFile, "none");
 SET_BOOL_PROP(FlowIstlSolverParams, UseGpu, false);
+SET_BOOL_PROP(FlowIstlSolverParams, LinearSolverOverlapCommunication, false);
 
 
 
@@ -123,6 +132,8 @@ namespace Opm
         int cpr_solver_verbose_;
         bool cpr_pressure_aggregation_;
         int cpr_reuse_setup_;
+        int cpr_coarsen_target_;
+        Dune::Amg::AccumulationMode cpr_accumulate_;
         CPRParameter() { reset(); }
 
         void reset()
@@ -140,6 +151,8 @@ namespace Opm
             cpr_solver_verbose_       = 0;
             cpr_pressure_aggregation_ = false;
             cpr_reuse_setup_          = 0;
+            cpr_coarsen_target_       = 1200;
+            cpr_accumulate_           = Dune::Amg::noAccu;
         }
     };
 
@@ -160,6 +173,7 @@ namespace Opm
         bool   ilu_redblack_;
         bool   ilu_reorder_sphere_;
         bool   newton_use_gmres_;
+        bool   use_pipelined_bicgstab_;
         bool   require_full_sparsity_pattern_;
         bool   ignoreConvergenceFailure_;
         bool   linear_solver_use_amg_;
@@ -169,6 +183,7 @@ namespace Opm
         std::string linear_solver_configuration_;
         std::string linear_solver_configuration_json_file_;
         bool use_gpu_;
+        bool linear_solver_overlap_communication_;
 
         template <class TypeTag>
         void init()
@@ -184,6 +199,7 @@ namespace Opm
             ilu_redblack_ = EWOMS_GET_PARAM(TypeTag, bool, IluRedblack);
             ilu_reorder_sphere_ = EWOMS_GET_PARAM(TypeTag, bool, IluReorderSpheres);
             newton_use_gmres_ = EWOMS_GET_PARAM(TypeTag, bool, UseGmres);
+            use_pipelined_bicgstab_ = EWOMS_GET_PARAM(TypeTag, bool, UsePipelinedBicgstab);
             require_full_sparsity_pattern_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern);
             ignoreConvergenceFailure_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure);
             linear_solver_use_amg_ = EWOMS_GET_PARAM(TypeTag, bool, UseAmg);
@@ -195,9 +211,12 @@ namespace Opm
             cpr_max_ell_iter_  =  EWOMS_GET_PARAM(TypeTag, int, CprMaxEllIter);
             cpr_ell_solvetype_  =  EWOMS_GET_PARAM(TypeTag, int, CprEllSolvetype);
             cpr_reuse_setup_  =  EWOMS_GET_PARAM(TypeTag, int, CprReuseSetup);
+            cpr_coarsen_target_  =  EWOMS_GET_PARAM(TypeTag, int, CprCoarsenTarget);
+            cpr_accumulate_  =  convertString2Accumulation(EWOMS_GET_PARAM(TypeTag, std::string, CprAccumulate));
             linear_solver_configuration_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSolverConfiguration);
             linear_solver_configuration_json_file_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile);
             use_gpu_ = EWOMS_GET_PARAM(TypeTag, bool, UseGpu);
+            linear_solver_overlap_communication_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverOverlapCommunication);
         }
 
         template <class TypeTag>
@@ -213,6 +232,7 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluRedblack, "Use red-black partioning for the ILU preconditioner");
             EWOMS_REGISTER_PARAM(TypeTag, bool, IluReorderSpheres, "Whether to reorder the entries of the matrix in the red-black ILU preconditioner in spheres starting at an edge. If false the original ordering is preserved in each color. Otherwise why try to ensure D4 ordering (in a 2D structured grid, the diagonal elements are consecutive).");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseGmres, "Use GMRES as the linear solver");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UsePipelinedBicgstab, "Use the pipelined BiCGSTAB as the linear solver, which hides the global reductions behind the preconditioner and the matrix-vector product");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverRequireFullSparsityPattern, "Produce the full sparsity pattern for the linear solver");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverIgnoreConvergenceFailure, "Continue with the simulation like nothing happened after the linear solver did not converge");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseAmg, "Use AMG as the linear solver's preconditioner");
@@ -224,9 +244,12 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, CprMaxEllIter, "MaxIterations of the elliptic pressure part of the cpr solver");
             EWOMS_REGISTER_PARAM(TypeTag, int, CprEllSolvetype, "Solver type of elliptic pressure solve (0: bicgstab, 1: cg, 2: only amg preconditioner)");
             EWOMS_REGISTER_PARAM(TypeTag, int, CprReuseSetup, "Reuse Amg Setup");
+            EWOMS_REGISTER_PARAM(TypeTag, int, CprCoarsenTarget, "The number of rows of the pressure AMG's coarsest level. If the coarse levels are accumulated, the average number of rows per process below which they are gathered onto fewer processes");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, CprAccumulate, "Gather the coarse levels of the pressure AMG onto fewer processes (none: keep all processes, atonce: gather onto one process which solves the coarsest level directly, successive: gather onto fewer processes level by level, requires ParMETIS or PT-Scotch)");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSolverConfiguration, "Configuration of solver valid is: ilu0 (default), cpr_quasiimpes, cpr_trueimpes or file (specified in LinearSolverConfigurationJsonFile) ");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile, "Filename of JSON configuration for flexible linear solver system.");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseGpu, "Use GPU cusparseSolver as the linear solver");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverOverlapCommunication, "Exchange the ghost values in the linear operator while the interior rows are multiplied instead of in the ILU0 preconditioner (only used with OwnerCellsFirst and without AMG/CPR)");
         }
 
         FlowLinearSolverParameters() { reset(); }
@@ -236,6 +259,7 @@ namespace Opm
         {
             use_cpr_     = false;
             newton_use_gmres_        = false;
+            use_pipelined_bicgstab_  = false;
             linear_solver_reduction_ = 1e-2;
             linear_solver_maxiter_   = 150;
             linear_solver_restart_   = 40;
@@ -249,6 +273,7 @@ namespace Opm
             ilu_redblack_             = false;
             ilu_reorder_sphere_       = true;
             use_gpu_                  = false;
+            linear_solver_overlap_communication_ = false;
         }
     };
 
@@ -27,8 +27,10 @@
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
 #include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
@@ -43,6 +45,11 @@
 #include <dune/istl/solvers.hh>
 #include <dune/istl/owneroverlapcopy.hh>
 #include <dune/istl/paamg/amg.hh>
+#if HAVE_MPI
+#include <dune/common/enumset.hh>
+#include <dune/common/parallel/interface.hh>
+#include <dune/common/parallel/mpitraits.hh>
+#endif
 
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
@@ -192,7 +199,13 @@ protected:
 /*!
    \brief Adapter to turn a matrix into a linear operator.
    Adapts a matrix to the assembled linear operator interface.
-   We assume parallel ordering, where ghost rows are located after interior rows
+   We assume parallel ordering, where ghost rows are located after interior rows.
+
+   If overlapCommunication is true, the operator makes the ghost values of its
+   input consistent itself: The exchange with the neighboring processes is
+   posted before the rows which only couple to interior cells are multiplied and
+   the rows at the process boundary are multiplied after the exchange is
+   finished. The preconditioner then does not need to communicate its result.
  */
 template<class M, class X, class Y, class WellModel, bool overlapping >
 class WellModelGhostLastMatrixAdapter : public Dune::AssembledLinearOperator<M,X,Y>
@@ -223,7 +236,8 @@ public:
                                      const M& A_for_precond,
                                      const WellModel& wellMod,
                                      const size_t interiorSize,
-                                     const std::any& parallelInformation OPM_UNUSED_NOMPI = std::any() )
+                                     const std::any& parallelInformation OPM_UNUSED_NOMPI = std::any(),
+                                     const bool overlapCommunication OPM_UNUSED_NOMPI = false )
         : A_( A ), A_for_precond_(A_for_precond), wellMod_( wellMod ), interiorSize_(interiorSize), comm_()
     {
 #if HAVE_MPI
@@ -232,18 +246,42 @@ public:
             const ParallelISTLInformation& info =
                 std::any_cast<const ParallelISTLInformation&>( parallelInformation);
             comm_.reset( new communication_type( info.communicator() ) );
+            overlapCommunication_ = overlapCommunication;
+        }
+
+        if (overlapCommunication_) {
+            for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+            {
+                bool border = false;
+                auto endc = (*row).end();
+                for (auto col = (*row).begin(); col != endc; ++col)
+                    border = border || col.index() >= interiorSize_;
+
+                if (border)
+                    borderRows_.push_back(row.index());
+                else
+                    interiorRows_.push_back(row.index());
+            }
         }
 #endif
     }
 
     virtual void apply( const X& x, Y& y ) const override
     {
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+#if HAVE_MPI
+        if (overlapCommunication_) {
+            beginHaloExchange_(x);
+            for (const auto rowIdx : interiorRows_)
+                mvRow_(rowIdx, x, y);
+            endHaloExchange_(x);
+            for (const auto rowIdx : borderRows_)
+                mvRow_(rowIdx, x, y);
+        }
+        else
+#endif
         {
-            y[row.index()]=0;
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).umv(x[col.index()], y[row.index()]);
+            for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+                mvRow_(row.index(), x, y);
         }
 
         // add well model modification to y
@@ -255,12 +293,22 @@ public:
     // y += \alpha * A * x
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+#if HAVE_MPI
+        if (overlapCommunication_) {
+            beginHaloExchange_(x);
+            for (const auto rowIdx : interiorRows_)
+                usmvRow_(rowIdx, alpha, x, y);
+            endHaloExchange_(x);
+            for (const auto rowIdx : borderRows_)
+                usmvRow_(rowIdx, alpha, x, y);
+        }
+        else
+#endif
         {
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).usmv(alpha, x[col.index()], y[row.index()]);
+            for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
+                usmvRow_(row.index(), alpha, x, y);
         }
+
         // add scaled well model modification to y
         wellMod_.applyScaleAdd( alpha, x, y );
 
@@ -274,6 +322,12 @@ public:
         return comm_.operator->();
     }
 
+    //! \brief Whether apply() makes the ghost values of its input consistent.
+    bool overlapCommunication() const
+    {
+        return overlapCommunication_;
+    }
+
 protected:
     void ghostLastProject(Y& y) const
     {
@@ -282,12 +336,126 @@ protected:
             y[i] = 0;
     }
 
+    void mvRow_(size_t rowIdx, const X& x, Y& y) const
+    {
+        const auto& row = A_[rowIdx];
+        y[rowIdx] = 0;
+        auto endc = row.end();
+        for (auto col = row.begin(); col != endc; ++col)
+            (*col).umv(x[col.index()], y[rowIdx]);
+    }
+
+    void usmvRow_(size_t rowIdx, field_type alpha, const X& x, Y& y) const
+    {
+        const auto& row = A_[rowIdx];
+        auto endc = row.end();
+        for (auto col = row.begin(); col != endc; ++col)
+            (*col).usmv(alpha, x[col.index()], y[rowIdx]);
+    }
+
+#if HAVE_MPI
+    struct Neighbor
+    {
+        int rank;
+        std::vector<std::size_t> sendIndices;
+        std::vector<std::size_t> recvIndices;
+        std::vector<field_type> sendBuffer;
+        std::vector<field_type> recvBuffer;
+    };
+
+    // The index set of the communicator is only filled when the solve starts,
+    // hence the neighbors are set up on the first exchange.
+    void setupNeighbors_() const
+    {
+        using AttributeSet = Dune::OwnerOverlapCopyAttributeSet;
+        using OwnerSet = Dune::EnumItem<AttributeSet::AttributeSet, AttributeSet::owner>;
+        using GhostSet = Dune::Combine<Dune::EnumItem<AttributeSet::AttributeSet, AttributeSet::overlap>,
+                                       Dune::EnumItem<AttributeSet::AttributeSet, AttributeSet::copy>,
+                                       AttributeSet::AttributeSet>;
+
+        Dune::Interface interface;
+        interface.build(comm_->remoteIndices(), OwnerSet(), GhostSet());
+        for (const auto& entry : interface.interfaces()) {
+            Neighbor neighbor;
+            neighbor.rank = entry.first;
+            const auto& send = entry.second.first;
+            const auto& recv = entry.second.second;
+            for (std::size_t i = 0; i < send.size(); ++i)
+                neighbor.sendIndices.push_back(send[i]);
+            for (std::size_t i = 0; i < recv.size(); ++i)
+                neighbor.recvIndices.push_back(recv[i]);
+            neighbor.sendBuffer.resize(neighbor.sendIndices.size() * blockSize_);
+            neighbor.recvBuffer.resize(neighbor.recvIndices.size() * blockSize_);
+            neighbors_.push_back(std::move(neighbor));
+        }
+        requests_.reserve(2 * neighbors_.size());
+        neighborsSetUp_ = true;
+    }
+
+    // Posts the receives of the ghost values and the sends of the owner values of x.
+    void beginHaloExchange_(const X& x) const
+    {
+        if (!neighborsSetUp_)
+            setupNeighbors_();
+
+        const MPI_Datatype type = Dune::MPITraits<field_type>::getType();
+        requests_.clear();
+        for (auto& neighbor : neighbors_) {
+            if (neighbor.recvIndices.empty())
+                continue;
+            requests_.emplace_back();
+            MPI_Irecv(neighbor.recvBuffer.data(), neighbor.recvBuffer.size(), type,
+                      neighbor.rank, haloTag_, comm_->communicator(), &requests_.back());
+        }
+        for (auto& neighbor : neighbors_) {
+            if (neighbor.sendIndices.empty())
+                continue;
+            auto value = neighbor.sendBuffer.begin();
+            for (const auto idx : neighbor.sendIndices)
+                value = std::copy(x[idx].begin(), x[idx].end(), value);
+            requests_.emplace_back();
+            MPI_Isend(neighbor.sendBuffer.data(), neighbor.sendBuffer.size(), type,
+                      neighbor.rank, haloTag_, comm_->communicator(), &requests_.back());
+        }
+    }
+
+    // Waits for the exchange and stores the received values in the ghost entries of x.
+    void endHaloExchange_(const X& x) const
+    {
+        MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+
+        // The operator interface gives us a const x, but updating its ghost
+        // values is exactly what copyOwnerToAll would have done before.
+        X& mutableX = const_cast<X&>(x);
+        for (const auto& neighbor : neighbors_) {
+            auto value = neighbor.recvBuffer.begin();
+            for (const auto idx : neighbor.recvIndices) {
+                std::copy(value, value + blockSize_, mutableX[idx].begin());
+                value += blockSize_;
+            }
+        }
+    }
+
+    static constexpr int blockSize_ = X::block_type::dimension;
+    static constexpr int haloTag_ = 4711;
+#endif
+
     const matrix_type& A_ ;
     const matrix_type& A_for_precond_ ;
     const WellModel& wellMod_;
     size_t interiorSize_;
 
     std::unique_ptr< communication_type > comm_;
+
+    bool overlapCommunication_ = false;
+#if HAVE_MPI
+    // owned rows without and with couplings to ghost cells
+    std::vector<size_t> interiorRows_;
+    std::vector<size_t> borderRows_;
+    mutable std::vector<Neighbor> neighbors_;
+    mutable std::vector<MPI_Request> requests_;
+    mutable bool neighborsSetUp_ = false;
+#endif
 };
 
     /// This class solves the fully implicit black-oil system by
@@ -363,6 +531,7 @@ protected:
             const bool useWellConn = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
 
             ownersFirst_ = EWOMS_GET_PARAM(TypeTag, bool, OwnerCellsFirst);
+            keepPreconditioner_ = EWOMS_GET_PARAM(TypeTag, bool, UseChordNewton);
             interiorCellNum_ = detail::numMatrixRowsToUseInSolver(simulator_.vanguard().grid(), ownersFirst_);
 
             if (!ownersFirst_ || parameters_.linear_solver_use_amg_  || parameters_.use_cpr_ ) {
@@ -384,6 +553,24 @@ protected:
             }
         }
 
+        /// Adds the memory used by the copy of the Jacobian which is scaled and
+        /// solved and by the ILU0 preconditioner, AMG hierarchies are not
+        /// accounted for.
+        void addMemoryUsage(MemoryReport& report) const
+        {
+            std::size_t copyBytes = 0;
+            if (matrix_)
+                copyBytes += matrixMemoryUsage(*matrix_);
+            if (noGhostMat_)
+                copyBytes += matrixMemoryUsage(*noGhostMat_);
+            report.add("Jacobian copy", copyBytes);
+
+            std::size_t preconditionerBytes = preconditionerMemory_ + weights_.size() * sizeof(BlockVector);
+            if (matrix_for_preconditioner_)
+                preconditionerBytes += matrixMemoryUsage(*matrix_for_preconditioner_);
+            report.add("Preconditioner", preconditionerBytes);
+        }
+
         // nothing to clean here
         void eraseMatrix() {
             matrix_for_preconditioner_.reset();
@@ -391,11 +578,28 @@ protected:
 
         void prepare(const SparseMatrixAdapter& M, Vector& b)
         {
-            matrix_.reset(new Matrix(M.istlMatrix()));
+            // the copy keeps its storage, so the ILU0 preconditioner can refactorize it
+            if (!matrix_ || !copyMatrixValues(M.istlMatrix(), *matrix_))
+                matrix_.reset(new Matrix(M.istlMatrix()));
             rhs_ = &b;
+            reusePreconditioner_ = false;
             this->scaleSystem();
         }
 
+        /// Prepares a solve with a new right hand side but the matrix of the
+        /// last call to prepare(), e.g. for a chord iteration of the Newton
+        /// method. The ILU0 preconditioner of the last solve is reused.
+        /// Without MatrixAddWellContributions the operator applies the Schur
+        /// complement of the wells from their current linearization, so only
+        /// the reservoir part of the operator is frozen.
+        void prepareResidual(Vector& b)
+        {
+            assert(matrix_);
+            rhs_ = &b;
+            reusePreconditioner_ = keepPreconditioner_;
+            this->scaleResidual();
+        }
+
         void scaleSystem()
         {
             const bool matrix_cont_added = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
@@ -423,7 +627,8 @@ protected:
                     // also scale weights
                     this->scaleEquationsAndVariables(weights_);
                 }
-                if (form_cpr && !(parameters_.cpr_use_drs_)) {
+                pressureRhsCombined_ = form_cpr && !(parameters_.cpr_use_drs_);
+                if (pressureRhsCombined_) {
                     scaleMatrixAndRhs(weights_);
                 }
                 if (weights_.size() == 0) {
@@ -435,6 +640,7 @@ protected:
                    OpmLog::warning("DRS_DISABLE", "Disabling DRS as matrix does not contain well contributions");
                 }
                 parameters_.cpr_use_drs_ = false;
+                pressureRhsCombined_ = false;
                 if (parameters_.scale_linear_system_) {
                     // also scale weights
                     this->scaleEquationsAndVariables(weights_);
@@ -442,6 +648,22 @@ protected:
             }
         }
 
+        /// Applies the scaling of scaleSystem() to the right hand side only.
+        void scaleResidual()
+        {
+            if (parameters_.scale_linear_system_) {
+                for (std::size_t i = 0; i < rhs_->size(); ++i) {
+                    BlockVector& brhs = (*rhs_)[i];
+                    for (std::size_t ii = 0; ii < brhs.size(); ii++) {
+                        brhs[ii] *= simulator_.model().eqWeight(i, ii);
+                    }
+                }
+            }
+            if (pressureRhsCombined_) {
+                scaleRhs(weights_);
+            }
+        }
+
         void setResidual(Vector& /* b */) {
             // rhs_ = &b; // Must be handled in prepare() instead.
         }
@@ -464,10 +686,15 @@ protected:
                 if ( ownersFirst_ && (!parameters_.linear_solver_use_amg_ || !parameters_.use_cpr_) ) {
                     typedef WellModelGhostLastMatrixAdapter< Matrix, Vector, Vector, WellModel, true > Operator;
                     Operator opA(*matrix_, *matrix_, wellModel, interiorCellNum_,
-                                 parallelInformation_ );
+                                 parallelInformation_, overlapCommunication() );
 
                     assert( opA.comm() );
                     solve( opA, x, *rhs_, *(opA.comm()) );
+
+                    // The preconditioner did not update the ghost values of the
+                    // corrections, they were only exchanged within the operator.
+                    if (opA.overlapCommunication())
+                        opA.comm()->copyOwnerToAll(x, x);
                 }
                 else {
 
@@ -509,6 +736,13 @@ protected:
         /// \copydoc NewtonIterationBlackoilInterface::parallelInformation
         const std::any& parallelInformation() const { return parallelInformation_; }
 
+        /// Whether the ghost-last operator exchanges the ghost values of its
+        /// input while it multiplies the interior rows.
+        bool overlapCommunication() const
+        {
+            return ownersFirst_ && parameters_.linear_solver_overlap_communication_;
+        }
+
     protected:
         /// \brief construct the CPR preconditioner and the solver.
         /// \tparam P The type of the parallel information.
@@ -592,19 +826,13 @@ protected:
                         }
 
                         // call Dune
-                        auto precond = constructPrecond(linearOperator, parallelInformation_arg);
-                        solve(linearOperator, x, istlb, *sp, *precond, result);
+                        solveWithIlu0(linearOperator, x, istlb, *sp, parallelInformation_arg, result);
                     }
                 } else { // gpu is not selected or disabled
-                    auto precond = constructPrecond(linearOperator, parallelInformation_arg);
-                    solve(linearOperator, x, istlb, *sp, *precond, result);
+                    solveWithIlu0(linearOperator, x, istlb, *sp, parallelInformation_arg, result);
                 }
 #else
-                // Construct preconditioner.
-                auto precond = constructPrecond(linearOperator, parallelInformation_arg);
-
-                // Solve.
-                solve(linearOperator, x, istlb, *sp, *precond, result);
+                solveWithIlu0(linearOperator, x, istlb, *sp, parallelInformation_arg, result);
 #endif
             }
         }
@@ -645,10 +873,79 @@ protected:
             const MILU_VARIANT ilu_milu  = parameters_.ilu_milu_;
             const bool ilu_redblack = parameters_.ilu_redblack_;
             const bool ilu_reorder_spheres = parameters_.ilu_reorder_sphere_;
-            return Pointer(new ParPreconditioner(opA.getmat(), comm, relax, ilu_milu, interiorCellNum_, ilu_redblack, ilu_reorder_spheres));
+            Pointer precond(new ParPreconditioner(opA.getmat(), comm, relax, ilu_milu, interiorCellNum_, ilu_redblack, ilu_reorder_spheres));
+            precond->setCopyOwnerToAll(!overlapCommunication());
+            return precond;
         }
 #endif
 
+        /// The ILU0 preconditioners are kept between the solves. They are
+        /// refactorized for a new Jacobian, which reuses their ordering and
+        /// sparsity pattern, unless a chord iteration reuses the factorization.
+        template <class Operator>
+        SeqPreconditioner& reusablePrecond(Operator& opA, const Dune::Amg::SequentialInformation& info) const
+        {
+            if (!seqPrecond_ || precondMatrix_ != &opA.getmat()) {
+                seqPrecond_ = constructPrecond(opA, info);
+                precondMatrix_ = &opA.getmat();
+            }
+            else if (!reusePreconditioner_)
+                seqPrecond_->update();
+            return *seqPrecond_;
+        }
+
+#if HAVE_MPI
+        template <class Operator>
+        ParPreconditioner& reusablePrecond(Operator& opA, const Comm& comm) const
+        {
+            if (!parPrecond_ || precondMatrix_ != &opA.getmat()) {
+                parPrecond_ = constructPrecond(opA, comm);
+                precondMatrix_ = &opA.getmat();
+                return *parPrecond_;
+            }
+
+            // the communication object is recreated for every solve
+            parPrecond_->setCommunication(comm);
+            if (!reusePreconditioner_)
+                parPrecond_->update();
+            return *parPrecond_;
+        }
+#endif
+
+        /// \brief Solve with the ILU0 preconditioner, which is kept for the
+        ///        next solve.
+        template <class LinearOperator, class ScalarProd, class POrComm>
+        void solveWithIlu0(LinearOperator& linearOperator, Vector& x, Vector& istlb, ScalarProd& sp,
+                           const POrComm& comm, Dune::InverseOperatorResult& result) const
+        {
+            auto& precond = reusablePrecond(linearOperator, comm);
+            preconditionerMemory_ = precond.memoryUsage();
+
+            solve(linearOperator, x, istlb, sp, precond, result);
+        }
+
+        /// Copies the values of a matrix with the sparsity pattern of target,
+        /// returns false without a complete copy if the patterns differ.
+        template <class SourceMatrix>
+        static bool copyMatrixValues(const SourceMatrix& source, Matrix& target)
+        {
+            if (source.N() != target.N() || source.nonzeroes() != target.nonzeroes())
+                return false;
+
+            auto targetRow = target.begin();
+            for (auto row = source.begin(); row != source.end(); ++row, ++targetRow) {
+                if (row->size() != targetRow->size())
+                    return false;
+                auto targetCol = targetRow->begin();
+                for (auto col = row->begin(); col != row->end(); ++col, ++targetCol) {
+                    if (col.index() != targetCol.index())
+                        return false;
+                    *targetCol = *col;
+                }
+            }
+            return true;
+        }
+
         template <class LinearOperator, class MatrixOperator, class POrComm, class AMG >
         void
         constructAMGPrecond(LinearOperator& /* linearOperator */, const POrComm& comm, std::unique_ptr< AMG >& amg, std::unique_ptr< MatrixOperator >& opA, const double relax, const MILU_VARIANT milu) const
@@ -687,6 +984,27 @@ protected:
                 // Solve system.
                 linsolve.apply(x, istlb, result);
             }
+            else if ( parameters_.use_pipelined_bicgstab_ ) {
+#if HAVE_MPI
+                if (parallelInformation_.type() == typeid(ParallelISTLInformation)) {
+                    const ParallelISTLInformation& info =
+                        std::any_cast<const ParallelISTLInformation&>( parallelInformation_);
+                    PipelinedBiCGSTABSolver<Vector> linsolve(opA, precond,
+                              parameters_.linear_solver_reduction_,
+                              parameters_.linear_solver_maxiter_,
+                              verbosity,
+                              info.updateOwnerMask(x),
+                              info.communicator());
+                    linsolve.apply(x, istlb, result);
+                    return;
+                }
+#endif
+                PipelinedBiCGSTABSolver<Vector> linsolve(opA, precond,
+                          parameters_.linear_solver_reduction_,
+                          parameters_.linear_solver_maxiter_,
+                          verbosity);
+                linsolve.apply(x, istlb, result);
+            }
             else { // BiCGstab solver
                 Dune::BiCGSTABSolver<Vector> linsolve(opA, sp, precond,
                           parameters_.linear_solver_reduction_,
@@ -902,10 +1220,7 @@ protected:
         Vector getStorageWeights() const
         {
             Vector weights(rhs_->size());
-            ElementContext elemCtx(simulator_);
-            Opm::Amg::getTrueImpesWeights(pressureVarIndex, weights, simulator_.vanguard().gridView(),
-                                          elemCtx, simulator_.model(),
-                                          ThreadManager::threadId());
+            Opm::Amg::getTrueImpesWeights<ElementContext>(pressureVarIndex, weights, simulator_);
             return weights;
         }
 
@@ -979,7 +1294,6 @@ protected:
             const auto endi = matrix_->end();
             for (auto i = matrix_->begin(); i !=endi; ++i) {
                 const BlockVector& bweights = weights[i.index()];
-                BlockVector& brhs = (*rhs_)[i.index()];
                 const auto endj = (*i).end();
                 for (auto j = (*i).begin(); j != endj; ++j) {
                     // assume it is something on all rows
@@ -992,6 +1306,15 @@ protected:
                     }
                     block[pressureEqnIndex] = neweq;
                 }
+            }
+            scaleRhs(weights);
+        }
+
+        void scaleRhs(const Vector& weights)
+        {
+            for (std::size_t i = 0; i < rhs_->size(); ++i) {
+                const BlockVector& bweights = weights[i];
+                BlockVector& brhs = (*rhs_)[i];
                 Scalar newrhs(0.0);
                 for (std::size_t ii = 0; ii < brhs.size(); ii++) {
                     newrhs += bweights[ii]*brhs[ii];
@@ -1052,6 +1375,18 @@ protected:
         FlowLinearSolverParameters parameters_;
         Vector weights_;
         bool scale_variables_;
+        mutable std::size_t preconditionerMemory_ = 0;
+
+        // the ILU0 preconditioner of the last solve, its factorization is
+        // reused by chord iterations
+        bool keepPreconditioner_ = false;
+        bool reusePreconditioner_ = false;
+        bool pressureRhsCombined_ = false;
+        mutable std::unique_ptr<SeqPreconditioner> seqPrecond_;
+        mutable const void* precondMatrix_ = nullptr;
+#if HAVE_MPI
+        mutable std::unique_ptr<ParPreconditioner> parPrecond_;
+#endif
     }; // end ISTLSolver
 
 } // namespace Opm
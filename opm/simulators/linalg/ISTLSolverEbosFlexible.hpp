@@ -25,6 +25,7 @@
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
 #include <opm/simulators/linalg/WriteSystemMatrixHelper.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
@@ -126,6 +127,14 @@ public:
     {
     }
 
+    // The flexible solver works on the Jacobian itself and does not expose the
+    // size of its preconditioner.
+    void addMemoryUsage(MemoryReport& report) const
+    {
+        report.add("Jacobian copy", 0);
+        report.add("Preconditioner", 0);
+    }
+
     void prepare(SparseMatrixAdapter& mat, VectorType& b)
     {
 #if HAVE_MPI
@@ -216,6 +225,21 @@ public:
         }
     }
 
+    // The solver works in place on the Jacobian of the linearizer. A chord
+    // iteration does not assemble the reservoir Jacobian again (see
+    // BlackoilModelEbos::assembleReservoir()), so the operator and the
+    // preconditioner are both the ones of the last call to prepare(). If the
+    // Jacobian was reassembled in between, this would combine the new matrix
+    // with a stale preconditioner instead.
+    void prepareResidual(VectorType& b)
+    {
+        assert(solver_);
+#if HAVE_MPI
+        makeOverlapRowsInvalid(*matrix_);
+#endif
+        rhs_ = b;
+    }
+
     bool solve(VectorType& x)
     {
         solver_->apply(x, rhs_, res_);
@@ -274,10 +298,7 @@ protected:
     VectorType getTrueImpesWeights(const VectorType& b,const int pressureVarIndex)
     {
         VectorType weights(b.size());
-        ElementContext elemCtx(simulator_);
-        Opm::Amg::getTrueImpesWeights(pressureVarIndex, weights, simulator_.vanguard().gridView(),
-                                      elemCtx, simulator_.model(),
-                                      ThreadManager::threadId());
+        Opm::Amg::getTrueImpesWeights<ElementContext>(pressureVarIndex, weights, simulator_);
         return weights;
     }
 
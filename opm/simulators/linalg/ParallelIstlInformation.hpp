@@ -30,8 +30,13 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 #if HAVE_MPI && HAVE_DUNE_ISTL
@@ -73,14 +78,16 @@ public:
     ParallelISTLInformation()
         : indexSet_(new ParallelIndexSet),
           remoteIndices_(new RemoteIndices(*indexSet_, *indexSet_, MPI_COMM_WORLD)),
-          communicator_(MPI_COMM_WORLD)
+          communicator_(MPI_COMM_WORLD),
+          ownerToAll_(std::make_shared<OwnerToAllCommunication>())
     {}
     /// \brief Constructs an empty parallel information object using a communicator.
     /// \param communicator The communicator to use.
     ParallelISTLInformation(MPI_Comm communicator)
         : indexSet_(new ParallelIndexSet),
           remoteIndices_(new RemoteIndices(*indexSet_, *indexSet_, communicator)),
-          communicator_(communicator)
+          communicator_(communicator),
+          ownerToAll_(std::make_shared<OwnerToAllCommunication>())
     {}
     /// \brief Constructs a parallel information object from the specified information.
     /// \param indexSet The parallel index set to use.
@@ -89,14 +96,15 @@ public:
     ParallelISTLInformation(const std::shared_ptr<ParallelIndexSet>& indexSet,
                             const std::shared_ptr<RemoteIndices>& remoteIndices,
                             MPI_Comm communicator)
-        : indexSet_(indexSet), remoteIndices_(remoteIndices), communicator_(communicator)
+        : indexSet_(indexSet), remoteIndices_(remoteIndices), communicator_(communicator),
+          ownerToAll_(std::make_shared<OwnerToAllCommunication>())
     {}
     /// \brief Copy constructor.
     ///
     /// The information will be shared by the the two objects.
     ParallelISTLInformation(const ParallelISTLInformation& other)
     : indexSet_(other.indexSet_), remoteIndices_(other.remoteIndices_),
-      communicator_(other.communicator_)
+      communicator_(other.communicator_), ownerToAll_(other.ownerToAll_)
     {}
     /// \brief Get a pointer to the underlying index set.
     std::shared_ptr<ParallelIndexSet> indexSet() const
@@ -141,24 +149,38 @@ public:
     /// \brief Communcate the dofs owned by us to the other process.
     ///
     /// Afterwards all associated dofs will contain the same data.
+    /// The communication interface is only set up again after the index set
+    /// has changed, and there is one communicator for each container type.
     template<class T>
     void copyOwnerToAll (const T& source, T& dest) const
     {
         typedef Dune::Combine<Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner>,Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::overlap>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> OwnerOverlapSet;
         typedef Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::owner> OwnerSet;
         typedef Dune::Combine<OwnerOverlapSet, Dune::EnumItem<Dune::OwnerOverlapCopyAttributeSet::AttributeSet,Dune::OwnerOverlapCopyAttributeSet::copy>,Dune::OwnerOverlapCopyAttributeSet::AttributeSet> AllSet;
-      OwnerSet sourceFlags;
-      AllSet destFlags;
-      Dune::Interface interface(communicator_);
+      OwnerToAllCommunication& cache = *ownerToAll_;
+      bool rebuild = !cache.interface || cache.indexSetSeqNo != indexSet_->seqNo();
       if( !remoteIndices_->isSynced() )
       {
           remoteIndices_->rebuild<false>();
+          rebuild = true;
       }
-      interface.build(*remoteIndices_,sourceFlags,destFlags);
-      Dune::BufferedCommunicator communicator;
-      communicator.template build<T>(interface);
-      communicator.template forward<CopyGatherScatter<T> >(source,dest);
-      communicator.free();
+      if( rebuild )
+      {
+          OwnerSet sourceFlags;
+          AllSet destFlags;
+          // The communicators refer to the interface and need to go first.
+          cache.communicators.clear();
+          cache.interface.reset(new Dune::Interface(communicator_));
+          cache.interface->build(*remoteIndices_,sourceFlags,destFlags);
+          cache.indexSetSeqNo = indexSet_->seqNo();
+      }
+      auto& communicator = cache.communicators[std::type_index(typeid(T))];
+      if( !communicator )
+      {
+          communicator.reset(new Dune::BufferedCommunicator);
+          communicator->template build<T>(*cache.interface);
+      }
+      communicator->template forward<CopyGatherScatter<T> >(source,dest);
     }
     template<class T>
     const std::vector<double>& updateOwnerMask(const T& container) const
@@ -259,15 +281,35 @@ private:
         std::tuple<ReturnValues...> init=values;
         updateOwnerMask(std::get<0>(containers));
         computeLocalReduction(containers, operators, values);
-        std::vector<std::tuple<ReturnValues...> > receivedValues(communicator_.size());
-        communicator_.allgather(&values, 1, &(receivedValues[0]));
+        // All the reductions are done by one allreduce with a user-defined operation.
+        communicator_.template allreduce<GlobalReductionFunctor<BinaryOperators...> >(&values, 1);
+        std::tuple<ReturnValues...> reduced=values;
         values=init;
-        for( auto rvals=receivedValues.begin(), endvals=receivedValues.end(); rvals!=endvals;
-             ++rvals )
+        computeGlobalReduction(reduced, operators, values);
+    }
+    /// \brief Combines the tuples of local reductions of two processes.
+    ///
+    /// Used as the user-defined MPI operation of computeTupleReduction. The
+    /// local operators have to be default constructible.
+    template<typename... BinaryOperators>
+    struct GlobalReductionFunctor
+    {
+        template<typename... ReturnValues>
+        std::tuple<ReturnValues...> operator()(const std::tuple<ReturnValues...>& t1,
+                                               const std::tuple<ReturnValues...>& t2)
         {
-            computeGlobalReduction(*rvals, operators, values);
+            return combine(t1, t2, std::index_sequence_for<ReturnValues...>());
         }
-    }
+    private:
+        template<typename B>
+        using LocalOperator = std::decay_t<decltype(std::declval<B&>().localOperator())>;
+
+        template<typename Tuple, std::size_t... I>
+        Tuple combine(const Tuple& t1, const Tuple& t2, std::index_sequence<I...>)
+        {
+            return Tuple(LocalOperator<BinaryOperators>()(std::get<I>(t1), std::get<I>(t2))...);
+        }
+    };
     /// \brief TMP for computing the the global reduction after receiving the local ones.
     ///
     /// End of recursion.
@@ -372,10 +414,20 @@ private:
         /// \brief The number of components/equations.
         std::size_t num_components_;
     };
+    /// \brief The communication set up by copyOwnerToAll.
+    struct OwnerToAllCommunication
+    {
+        /// \brief The sequence number of the index set the interface was built for.
+        int indexSetSeqNo = -1;
+        std::unique_ptr<Dune::Interface> interface;
+        /// \brief The communicators of the container types, they depend on the block size.
+        std::map<std::type_index, std::unique_ptr<Dune::BufferedCommunicator> > communicators;
+    };
     std::shared_ptr<ParallelIndexSet> indexSet_;
     std::shared_ptr<RemoteIndices> remoteIndices_;
     Dune::CollectiveCommunication<MPI_Comm> communicator_;
     mutable std::vector<double> ownerMask_;
+    std::shared_ptr<OwnerToAllCommunication> ownerToAll_;
 };
 
     namespace Reduction
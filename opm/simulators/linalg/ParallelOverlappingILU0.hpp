@@ -34,7 +34,10 @@
 #include <numeric>
 #include <limits>
 #include <cstddef>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Opm
 {
@@ -339,9 +342,11 @@ namespace Opm
                             diagonal);
     }
 
+    //! Create the sparsity pattern of the ILU-n decomposition of the reordered
+    //! matrix A in ILU, which is in row_wise build mode.
     template<class M>
-    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
-                             Reorderer& ordering, Reorderer& inverseOrdering)
+    void milun_sparsity_pattern(const M& A, int n, M& ILU,
+                                Reorderer& ordering, Reorderer& inverseOrdering)
     {
         using Map = std::map<std::size_t, int>;
 
@@ -396,6 +401,13 @@ namespace Opm
                 (*col)[0][0] = generationPair->second;
             }
         }
+    }
+
+    template<class M>
+    void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
+                             Reorderer& ordering, Reorderer& inverseOrdering)
+    {
+        milun_sparsity_pattern(A, n, ILU, ordering, inverseOrdering);
 
         // copy Entries from A
         for(auto iter=A.begin(), iend = A.end(); iter != iend; ++iter)
@@ -583,6 +595,50 @@ namespace Opm
         }
         assert(colcount == numUpper);
       }
+
+      //! Copy the values of A to the CRS storage created by convertToCRS for
+      //! a matrix with the same sparsity pattern.
+      template<class M, class CRS, class InvVector>
+      void copyValuesToCRS(const M& A, CRS& lower, CRS& upper, InvVector& inv )
+      {
+        if ( A.N() == 0 )
+        {
+          return;
+        }
+
+        typedef typename M :: size_type size_type;
+
+        size_type colcount = 0;
+        const auto endi = A.end();
+        for (auto i=A.begin(); i!=endi; ++i)
+        {
+          const size_type iIndex = i.index();
+          for (auto j=(*i).begin(); j.index() < iIndex; ++j )
+          {
+            lower.values_[ colcount++ ] = (*j);
+          }
+        }
+        assert(colcount == lower.nonZeros());
+
+        // upper and inv are stored in reverse order, see convertToCRS
+        const auto rendi = A.beforeBegin();
+        size_type row = 0;
+        colcount = 0;
+        for (auto i=A.beforeEnd(); i!=rendi; --i, ++ row )
+        {
+          const size_type iIndex = i.index();
+          for (auto j=(*i).beforeEnd(); j.index()>=iIndex; --j )
+          {
+            if( j.index() == iIndex )
+            {
+              inv[ row ] = (*j);
+              break;
+            }
+            upper.values_[ colcount++ ] = (*j);
+          }
+        }
+        assert(colcount == upper.nonZeros());
+      }
     } // end namespace detail
 
 
@@ -668,6 +724,13 @@ protected:
           nRows_= 0;
       }
 
+      std::size_t memoryUsage() const
+      {
+          return rows_.capacity() * sizeof(size_type)
+              + values_.capacity() * sizeof(block_type)
+              + cols_.capacity() * sizeof(size_type);
+      }
+
       std::vector< size_type  > rows_;
       std::vector< block_type > values_;
       std::vector< size_type  > cols_;
@@ -895,7 +958,9 @@ public:
             inv_[ i ].mv( rhs, vBlock);
         }
 
-        copyOwnerToAll( mv );
+        if( copyOwnerToAll_ ) {
+            copyOwnerToAll( mv );
+        }
 
         if( relaxation_ ) {
             mv *= w_;
@@ -903,6 +968,28 @@ public:
         reorderBack(mv, v);
     }
 
+    /*!
+      \brief Whether apply() makes the ghost values of its result consistent.
+
+      This is not needed if the operator exchanges the ghost values of its
+      input itself.
+    */
+    void setCopyOwnerToAll(bool copy)
+    {
+        copyOwnerToAll_ = copy;
+    }
+
+    /*!
+      \brief Replace the communication object.
+
+      Needed if the decomposition is reused for a solve with a new
+      communication object for the same index set.
+    */
+    void setCommunication(const ParallelInfo& comm)
+    {
+        comm_ = &comm;
+    }
+
     template <class V>
     void copyOwnerToAll( V& v ) const
     {
@@ -921,6 +1008,25 @@ public:
         DUNE_UNUSED_PARAMETER(x);
     }
 
+    //! \brief Returns the number of bytes held by the decomposition.
+    std::size_t memoryUsage() const
+    {
+        using RangeBlock = typename Range::block_type;
+        using DomainBlock = typename Domain::block_type;
+        std::size_t iluBytes = 0;
+        if ( ILU_ )
+        {
+            iluBytes = ILU_->nonzeroes() * (sizeof(block_type) + sizeof(size_type))
+                + ILU_->N() * sizeof(typename matrix_type::row_type);
+        }
+        return lower_.memoryUsage() + upper_.memoryUsage()
+            + inv_.capacity() * sizeof(block_type)
+            + iluBytes + valueMap_.capacity() * sizeof(block_type*)
+            + ordering_.capacity() * sizeof(std::size_t)
+            + reorderedD_.size() * sizeof(RangeBlock)
+            + reorderedV_.size() * sizeof(DomainBlock);
+    }
+
     virtual void update() override
     {
         // (For older DUNE versions the communicator might be
@@ -943,8 +1049,68 @@ public:
         std::string message;
         const int rank = ( comm_ ) ? comm_->communicator().rank() : 0;
 
-        std::unique_ptr< Matrix > ILU;
+        // The ordering, the sparsity pattern of the decomposition and the
+        // layout of its CRS storage only depend on the sparsity pattern of
+        // the matrix, so they are only set up again for a new matrix.
+        const bool newPattern = !ILU_ || symbolicMatrix_ != A_
+            || symbolicRows_ != A_->N() || symbolicNonzeroes_ != A_->nonzeroes();
+        if ( newPattern )
+        {
+            setupSymbolic_();
+        }
+
+        try
+        {
+            // copy the values of the matrix to their (reordered) positions
+            // in the decomposition, the fill-in of ILU-n starts with zero.
+            if ( iluIteration_ > 0 )
+            {
+                *ILU_ = 0.0;
+            }
+            auto entry = valueMap_.begin();
+            for ( auto row = A_->begin(), rend = A_->end(); row != rend; ++row )
+            {
+                for ( auto col = row->begin(), cend = row->end(); col != cend; ++col, ++entry )
+                {
+                    **entry = *col;
+                }
+            }
 
+            factorize_();
+        }
+        catch (const Dune::MatrixBlockError& error)
+        {
+            message = error.what();
+            std::cerr<<"Exception occured on process " << rank << " during " <<
+                "setup of ILU0 preconditioner with message: " <<
+                message<<std::endl;
+            ilu_setup_successful = 0;
+        }
+
+        // Check whether there was a problem on some process
+        const bool parallel_failure = comm_ && comm_->communicator().min(ilu_setup_successful) == 0;
+        const bool local_failure = ilu_setup_successful == 0;
+        if ( local_failure || parallel_failure )
+        {
+            throw Dune::MatrixBlockError();
+        }
+
+        // store ILU in simple CRS format
+        if ( newPattern )
+        {
+            detail::convertToCRS( *ILU_, lower_, upper_, inv_ );
+        }
+        else
+        {
+            detail::copyValuesToCRS( *ILU_, lower_, upper_, inv_ );
+        }
+    }
+
+protected:
+    /// \brief Compute the ordering and the sparsity pattern of the decomposition.
+    void setupSymbolic_()
+    {
+        ordering_.clear();
         if ( redBlack_ )
         {
             using Graph = Dune::Amg::MatrixGraph<const Matrix>;
@@ -972,100 +1138,92 @@ public:
             inverseOrdering[newIndex] = index++;
         }
 
-        try
-        {
-            if( iluIteration_ == 0 ) {
-                // create ILU-0 decomposition
-                if ( ordering_.empty() )
-                {
-                    ILU.reset( new Matrix( *A_ ) );
-                }
-                else
+        if( iluIteration_ == 0 ) {
+            // the pattern of ILU-0 is the one of the (reordered) matrix
+            if ( ordering_.empty() )
+            {
+                ILU_.reset( new Matrix( *A_ ) );
+            }
+            else
+            {
+                ILU_.reset( new Matrix(A_->N(), A_->M(), A_->nonzeroes(), Matrix::row_wise));
+                auto& newA = *ILU_;
+                // Create sparsity pattern
+                for(auto iter=newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
                 {
-                    ILU.reset( new Matrix(A_->N(), A_->M(), A_->nonzeroes(), Matrix::row_wise));
-                    auto& newA = *ILU;
-                    // Create sparsity pattern
-                    for(auto iter=newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
-                    {
-                        const auto& row = (*A_)[inverseOrdering[iter.index()]];
-                        for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
-                        {
-                            iter.insert(ordering_[col.index()]);
-                        }
-                    }
-                    // Copy values
-                    for(auto iter = A_->begin(), iend = A_->end(); iter != iend; ++iter)
+                    const auto& row = (*A_)[inverseOrdering[iter.index()]];
+                    for(auto col = row.begin(), cend = row.end(); col != cend; ++col)
                     {
-                        auto& newRow = newA[ordering_[iter.index()]];
-                        for(auto col = iter->begin(), cend = iter->end(); col != cend; ++col)
-                        {
-                            newRow[ordering_[col.index()]] = *col;
-                        }
+                        iter.insert(ordering_[col.index()]);
                     }
                 }
-
-                switch ( milu_ )
-                {
-                case MILU_VARIANT::MILU_1:
-                    detail::milu0_decomposition ( *ILU);
-                    break;
-                case MILU_VARIANT::MILU_2:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
-                                                  detail::SignFunctor() );
-                    break;
-                case MILU_VARIANT::MILU_3:
-                    detail::milu0_decomposition ( *ILU, detail::AbsFunctor(),
-                                                  detail::SignFunctor() );
-                    break;
-                case MILU_VARIANT::MILU_4:
-                    detail::milu0_decomposition ( *ILU, detail::IdentityFunctor(),
-                                                  detail::IsPositiveFunctor() );
-                    break;
-                default:
-                    if (interiorSize_ == A_->N())
-                        bilu0_decomposition( *ILU );
-                    else
-                        detail::ghost_last_bilu0_decomposition(*ILU, interiorSize_);
-                    break;
-                }
             }
-            else {
-                // create ILU-n decomposition
-                ILU.reset( new Matrix( A_->N(), A_->M(), Matrix::row_wise) );
-                std::unique_ptr<detail::Reorderer> reorderer, inverseReorderer;
-                if ( ordering_.empty() )
-                {
-                    reorderer.reset(new detail::NoReorderer());
-                    inverseReorderer.reset(new detail::NoReorderer());
-                }
-                else
-                {
-                    reorderer.reset(new detail::RealReorderer(ordering_));
-                    inverseReorderer.reset(new detail::RealReorderer(inverseOrdering));
-                }
-
-                milun_decomposition( *A_, iluIteration_, milu_, *ILU, *reorderer, *inverseReorderer );
+        }
+        else {
+            // create the pattern of the ILU-n decomposition
+            ILU_.reset( new Matrix( A_->N(), A_->M(), Matrix::row_wise) );
+            std::unique_ptr<detail::Reorderer> reorderer, inverseReorderer;
+            if ( ordering_.empty() )
+            {
+                reorderer.reset(new detail::NoReorderer());
+                inverseReorderer.reset(new detail::NoReorderer());
             }
+            else
+            {
+                reorderer.reset(new detail::RealReorderer(ordering_));
+                inverseReorderer.reset(new detail::RealReorderer(inverseOrdering));
+            }
+
+            detail::milun_sparsity_pattern( *A_, iluIteration_, *ILU_, *reorderer, *inverseReorderer );
         }
-        catch (const Dune::MatrixBlockError& error)
+
+        // the position in the decomposition of each entry of the matrix,
+        // in the order in which the matrix stores them
+        valueMap_.clear();
+        valueMap_.reserve( A_->nonzeroes() );
+        for ( auto row = A_->begin(), rend = A_->end(); row != rend; ++row )
         {
-            message = error.what();
-            std::cerr<<"Exception occured on process " << rank << " during " <<
-                "setup of ILU0 preconditioner with message: " <<
-                message<<std::endl;
-            ilu_setup_successful = 0;
+            const auto newRow = ordering_.empty() ? row.index() : ordering_[row.index()];
+            auto& iluRow = (*ILU_)[newRow];
+            for ( auto col = row->begin(), cend = row->end(); col != cend; ++col )
+            {
+                const auto newCol = ordering_.empty() ? col.index() : ordering_[col.index()];
+                valueMap_.push_back( &iluRow[newCol] );
+            }
         }
 
-        // Check whether there was a problem on some process
-        const bool parallel_failure = comm_ && comm_->communicator().min(ilu_setup_successful) == 0;
-        const bool local_failure = ilu_setup_successful == 0;
-        if ( local_failure || parallel_failure )
+        symbolicMatrix_ = A_;
+        symbolicRows_ = A_->N();
+        symbolicNonzeroes_ = A_->nonzeroes();
+    }
+
+    /// \brief Factorize the decomposition in place.
+    void factorize_()
+    {
+        switch ( milu_ )
         {
-            throw Dune::MatrixBlockError();
+        case MILU_VARIANT::MILU_1:
+            detail::milu0_decomposition ( *ILU_);
+            break;
+        case MILU_VARIANT::MILU_2:
+            detail::milu0_decomposition ( *ILU_, detail::IdentityFunctor(),
+                                          detail::SignFunctor() );
+            break;
+        case MILU_VARIANT::MILU_3:
+            detail::milu0_decomposition ( *ILU_, detail::AbsFunctor(),
+                                          detail::SignFunctor() );
+            break;
+        case MILU_VARIANT::MILU_4:
+            detail::milu0_decomposition ( *ILU_, detail::IdentityFunctor(),
+                                          detail::IsPositiveFunctor() );
+            break;
+        default:
+            if (iluIteration_ > 0 || interiorSize_ == A_->N())
+                bilu0_decomposition( *ILU_ );
+            else
+                detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
+            break;
         }
-
-        // store ILU in simple CRS format
-        detail::convertToCRS( *ILU, lower_, upper_, inv_ );
     }
 
 protected:
@@ -1129,6 +1287,14 @@ protected:
     std::vector< block_type > inv_;
     //! \brief the reordering of the unknowns
     std::vector< std::size_t > ordering_;
+    //! \brief The decomposition in matrix form, factorized in place.
+    std::unique_ptr< Matrix > ILU_;
+    //! \brief The entry of the decomposition of each nonzero of the matrix.
+    std::vector< block_type* > valueMap_;
+    //! \brief The matrix whose sparsity pattern ILU_ was set up for.
+    const Matrix* symbolicMatrix_ = nullptr;
+    size_type symbolicRows_ = 0;
+    size_type symbolicNonzeroes_ = 0;
     //! \brief The reordered right hand side
     Range reorderedD_;
     //! \brief The reordered left hand side.
@@ -1144,6 +1310,7 @@ protected:
     MILU_VARIANT milu_;
     bool redBlack_;
     bool reorderSphere_;
+    bool copyOwnerToAll_ = true;
 };
 
 } // end namespace Opm
@@ -0,0 +1,324 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
+#define OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+#if HAVE_MPI
+#include <dune/common/parallel/mpitraits.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#endif
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+namespace Opm
+{
+
+/*!
+  \brief Pipelined BiCGSTAB with right preconditioning.
+
+  Instead of the four blocking reductions of the textbook method, every
+  iteration computes its dot products in two groups. Each group is summed by
+  a single non-blocking allreduce, which is in flight while the preconditioner
+  and the operator are applied to the next search direction. The residual
+  norm is part of the second group, so the convergence test costs no extra
+  communication.
+
+  The algorithm is p-BiCGStab of Cools and Vanroose, "The communication-hiding
+  pipelined BiCGstab method for the parallel solution of large unsymmetric
+  linear systems", Parallel Computing 65 (2017). It keeps more vectors than
+  BiCGSTAB and the recurrences of the residual may drift a little from the
+  true residual, which the convergence test does not detect.
+*/
+template <class X>
+class PipelinedBiCGSTABSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    using field_type = typename X::field_type;
+    using LinearOperator = Dune::LinearOperator<X, X>;
+    using Preconditioner = Dune::Preconditioner<X, X>;
+
+    /// Create a sequential solver.
+    PipelinedBiCGSTABSolver(LinearOperator& op, Preconditioner& prec,
+                            double reduction, int maxit, int verbose)
+        : op_(op), prec_(prec), reduction_(reduction), maxit_(maxit), verbose_(verbose)
+    {}
+
+#if HAVE_MPI
+    /// Create a parallel solver.
+    /// \param ownerMask 1 for the blocks owned by this process, 0 otherwise.
+    /// \param comm      The communicator which the dot products are summed over.
+    PipelinedBiCGSTABSolver(LinearOperator& op, Preconditioner& prec,
+                            double reduction, int maxit, int verbose,
+                            const std::vector<double>& ownerMask, MPI_Comm comm)
+        : op_(op), prec_(prec), reduction_(reduction), maxit_(maxit), verbose_(verbose),
+          ownerMask_(ownerMask), comm_(comm)
+    {}
+#endif
+
+    virtual void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    virtual void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        Dune::Timer watch;
+        res.clear();
+
+        // b is overwritten by the residual, just like in Dune::BiCGSTABSolver
+        X& r = b;
+        op_.applyscaleadd(-1.0, x, r);
+        prec_.pre(x, r);
+
+        X r0(r);
+        X rt(x), w(x), wt(x), t(x);
+        precondition_(rt, r);
+        op_.apply(rt, w);
+        precondition_(wt, w);
+        op_.apply(wt, t);
+
+        dots_[0] = localDot_(r0, r);
+        dots_[1] = localDot_(r0, w);
+        dots_[2] = localDot_(r, r);
+        beginSum_(3);
+        endSum_();
+
+        const field_type def0 = std::sqrt(sums_[2]);
+        if (verbose_ > 0) {
+            std::cout << "=== PipelinedBiCGSTABSolver" << std::endl;
+            if (verbose_ > 1)
+                printIteration_(0, def0, def0);
+        }
+        if (def0 < 1e-30) {
+            res.converged = true;
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            prec_.post(x);
+            return;
+        }
+
+        field_type rho = sums_[0];
+        field_type alpha = rho / sums_[1];
+        field_type beta = 0.0;
+        field_type omega = 0.0;
+
+        X p(x), s(x), st(x), z(x), zt(x), v(x);
+        p = 0.0; s = 0.0; st = 0.0; z = 0.0; zt = 0.0; v = 0.0;
+        X q(x), qt(x), y(x);
+
+        field_type def = def0;
+        int it = 1;
+        for (; it <= maxit_; ++it) {
+            // the new search directions, each one only uses old vectors
+            update_(p, beta, -beta*omega, st, rt);
+            update_(s, beta, -beta*omega, z, w);
+            update_(st, beta, -beta*omega, zt, wt);
+            update_(z, beta, -beta*omega, v, t);
+
+            q = r;
+            q.axpy(-alpha, s);
+            qt = rt;
+            qt.axpy(-alpha, st);
+            y = w;
+            y.axpy(-alpha, z);
+
+            dots_[0] = localDot_(q, y);
+            dots_[1] = localDot_(y, y);
+            beginSum_(2);
+            precondition_(zt, z);
+            op_.apply(zt, v);
+            endSum_();
+
+            // y vanishes only together with q
+            omega = sums_[1] > 0.0 ? sums_[0] / sums_[1] : 0.0;
+
+            x.axpy(alpha, p);
+            x.axpy(omega, qt);
+
+            r = q;
+            r.axpy(-omega, y);
+            rt = qt;
+            rt.axpy(-omega, wt);
+            rt.axpy(omega*alpha, zt);
+            w = y;
+            w.axpy(-omega, t);
+            w.axpy(omega*alpha, v);
+
+            dots_[0] = localDot_(r0, r);
+            dots_[1] = localDot_(r0, w);
+            dots_[2] = localDot_(r0, s);
+            dots_[3] = localDot_(r0, z);
+            dots_[4] = localDot_(r, r);
+            beginSum_(5);
+            precondition_(wt, w);
+            op_.apply(wt, t);
+            endSum_();
+
+            const field_type defNew = std::sqrt(sums_[4]);
+            if (verbose_ > 1)
+                printIteration_(it, defNew, def);
+            def = defNew;
+            if (def < def0*reduction || def < 1e-30)
+                break;
+
+            if (std::abs(omega) < 1e-80)
+                DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTAB - omega "
+                           << omega << " <= EPSILON 1e-80 after " << it << " iterations");
+            if (std::abs(rho) < 1e-80)
+                DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTAB - rho "
+                           << rho << " <= EPSILON 1e-80 after " << it << " iterations");
+
+            const field_type rhoNew = sums_[0];
+            beta = (alpha / omega) * (rhoNew / rho);
+            alpha = rhoNew / (sums_[1] + beta*sums_[2] - beta*omega*sums_[3]);
+            rho = rhoNew;
+        }
+        it = std::min(it, maxit_);
+
+        prec_.post(x);
+
+        res.iterations = it;
+        res.reduction = def / def0;
+        res.converged = def < def0*reduction || def < 1e-30;
+        res.conv_rate = std::pow(res.reduction, 1.0 / it);
+        res.elapsed = watch.elapsed();
+
+        if (verbose_ > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / it
+                      << ", IT=" << it << std::endl;
+        }
+    }
+
+    virtual Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::category(op_);
+    }
+
+private:
+    // v = M^{-1} d
+    void precondition_(X& v, const X& d)
+    {
+        v = 0.0;
+        prec_.apply(v, d);
+    }
+
+    // v = a*v + b*u + w
+    static void update_(X& v, field_type a, field_type b, const X& u, const X& w)
+    {
+        v *= a;
+        v.axpy(b, u);
+        v += w;
+    }
+
+    // The contribution of this process to the dot product of x and y.
+    field_type localDot_(const X& x, const X& y) const
+    {
+        field_type result = 0.0;
+        if (ownerMask_.empty()) {
+            for (std::size_t i = 0; i < x.size(); ++i)
+                result += x[i] * y[i];
+        }
+        else {
+            for (std::size_t i = 0; i < x.size(); ++i)
+                result += ownerMask_[i] * (x[i] * y[i]);
+        }
+        return result;
+    }
+
+    // Starts the global sum of the first n local dot products.
+    void beginSum_(int n)
+    {
+#if HAVE_MPI
+        if (comm_ != MPI_COMM_NULL) {
+            MPI_Iallreduce(dots_.data(), sums_.data(), n, Dune::MPITraits<field_type>::getType(),
+                           MPI_SUM, comm_, &request_);
+            return;
+        }
+#endif
+        std::copy(dots_.begin(), dots_.begin() + n, sums_.begin());
+    }
+
+    // Waits until the sums are available.
+    void endSum_()
+    {
+#if HAVE_MPI
+        if (comm_ != MPI_COMM_NULL)
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+#endif
+    }
+
+    void printIteration_(int it, field_type def, field_type defOld) const
+    {
+        std::cout << std::setw(5) << it << "  "
+                  << std::scientific << std::setprecision(4) << def << "  "
+                  << def / defOld << std::defaultfloat << std::endl;
+    }
+
+    LinearOperator& op_;
+    Preconditioner& prec_;
+    double reduction_;
+    int maxit_;
+    int verbose_;
+
+    std::vector<double> ownerMask_;
+    std::array<field_type, 5> dots_;
+    std::array<field_type, 5> sums_;
+#if HAVE_MPI
+    MPI_Comm comm_ = MPI_COMM_NULL;
+    MPI_Request request_;
+#endif
+};
+
+#if HAVE_MPI
+/// \brief Returns 1 for the blocks owned by this process and 0 for the others.
+template <class Comm>
+std::vector<double> makeOwnerMask(const Comm& comm, std::size_t size)
+{
+    std::vector<double> mask(size, 1.0);
+    for (const auto& idx : comm.indexSet()) {
+        if (idx.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner)
+            mask[idx.local().local()] = 0.0;
+    }
+    return mask;
+}
+#endif
+
+} // namespace Opm
+
+#endif // OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
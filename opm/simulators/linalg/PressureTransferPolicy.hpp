@@ -24,6 +24,10 @@
 
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
 
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
 
 namespace Opm
 {
@@ -58,6 +62,7 @@ public:
             ++createIter;
         }
 
+        createWeightIndices_(fineLevelMatrix);
         calculateCoarseEntries(fineOperator);
         coarseLevelCommunication_.reset(communication_, [](Communication*) {});
 
@@ -76,29 +81,29 @@ public:
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
         const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
-                assert(entry.index() == entryCoarse.index());
-                double matrix_el = 0;
-                if (transpose) {
-                    const auto& bw = weights_[entry.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
-                    }
-                } else {
-                    const auto& bw = weights_[row.index()];
-                    for (size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
-                    }
-                }
-                (*entryCoarse) = matrix_el;
+        const auto* fineValues = blockValues_(fineMatrix);
+        auto* coarseValues = blockValues_(*coarseLevelMatrix_);
+        if (!fineValues || !coarseValues) {
+            calculateCoarseEntriesByRows_(fineMatrix);
+            return;
+        }
+
+        // the coarse matrix has the sparsity of the fine one, so each coarse
+        // value is computed from the fine block at the same position.
+        const int numEntries = weightIndex_.size();
+        assert(static_cast<std::size_t>(numEntries) == fineMatrix.nonzeroes());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int entryIdx = 0; entryIdx < numEntries; ++entryIdx) {
+            const auto& block = fineValues[entryIdx];
+            const auto& bw = weights_[weightIndex_[entryIdx]];
+            double matrix_el = 0;
+            for (std::size_t i = 0; i < bw.size(); ++i) {
+                matrix_el += (transpose ? block[pressure_var_index_][i] : block[i][pressure_var_index_]) * bw[i];
             }
+            coarseValues[entryIdx] = matrix_el;
         }
-        assert(rowCoarse == coarseLevelMatrix_->end());
     }
 
     virtual void moveToCoarseLevel(const typename ParentType::FineRangeType& fine) override
@@ -151,11 +156,76 @@ public:
     }
 
 private:
+    // The weights of an entry are the ones of its row, or of its column for
+    // the transposed system.
+    template <class Matrix>
+    void createWeightIndices_(const Matrix& fineMatrix)
+    {
+        weightIndex_.clear();
+        weightIndex_.reserve(fineMatrix.nonzeroes());
+        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row) {
+            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry) {
+                weightIndex_.push_back(transpose ? entry.index() : row.index());
+            }
+        }
+    }
+
+    // Returns the blocks of a matrix as one array in the order of the rows,
+    // nullptr if they are not stored contiguously.
+    template <class Matrix>
+    static auto blockValues_(Matrix& matrix) -> decltype(&*matrix.begin()->begin())
+    {
+        decltype(&*matrix.begin()->begin()) values = nullptr;
+        std::size_t offset = 0;
+        for (auto row = matrix.begin(), rowEnd = matrix.end(); row != rowEnd; ++row) {
+            if (row->size() == 0) {
+                continue;
+            }
+            if (!values) {
+                values = &*row->begin();
+            } else if (&*row->begin() != values + offset) {
+                return nullptr;
+            }
+            offset += row->size();
+        }
+        return values;
+    }
+
+    template <class Matrix>
+    void calculateCoarseEntriesByRows_(const Matrix& fineMatrix)
+    {
+        *coarseLevelMatrix_ = 0;
+        auto rowCoarse = coarseLevelMatrix_->begin();
+        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
+            assert(row.index() == rowCoarse.index());
+            auto entryCoarse = rowCoarse->begin();
+            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
+                assert(entry.index() == entryCoarse.index());
+                double matrix_el = 0;
+                if (transpose) {
+                    const auto& bw = weights_[entry.index()];
+                    for (size_t i = 0; i < bw.size(); ++i) {
+                        matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
+                    }
+                } else {
+                    const auto& bw = weights_[row.index()];
+                    for (size_t i = 0; i < bw.size(); ++i) {
+                        matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
+                    }
+                }
+                (*entryCoarse) = matrix_el;
+            }
+        }
+        assert(rowCoarse == coarseLevelMatrix_->end());
+    }
+
     Communication* communication_;
     const FineVectorType& weights_;
     const int pressure_var_index_;
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
+    // the index of the weights of each entry of the fine matrix
+    std::vector<std::size_t> weightIndex_;
 };
 
 } // namespace Opm
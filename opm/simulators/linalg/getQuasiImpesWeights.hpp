@@ -20,8 +20,18 @@
 #ifndef OPM_GET_QUASI_IMPES_WEIGHTS_HEADER_INCLUDED
 #define OPM_GET_QUASI_IMPES_WEIGHTS_HEADER_INCLUDED
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
+#include <dune/common/fvector.hh>
+
 #include <algorithm>
 #include <cmath>
+#include <exception>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Opm
 {
@@ -50,28 +60,41 @@ namespace Amg
         const Matrix& A = matrix;
         VectorBlockType rhs(0.0);
         rhs[pressureVarIndex] = 1.0;
-        const auto endi = A.end();
-        for (auto i = A.begin(); i != endi; ++i) {
-            const auto endj = (*i).end();
-            MatrixBlockType diag_block(0.0);
-            for (auto j = (*i).begin(); j != endj; ++j) {
-                if (i.index() == j.index()) {
-                    diag_block = (*j);
-                    break;
+        const int numRows = A.N();
+        // exceptions must not leave an OpenMP region, singular blocks are
+        // reported after the loop.
+        std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            try {
+                // the column indices of a row are sorted, so the diagonal block can
+                // be found by a binary search instead of scanning the whole row.
+                const auto& rowRef = A[row];
+                const auto diag = rowRef.find(row);
+                const MatrixBlockType diag_block = (diag != rowRef.end()) ? *diag : MatrixBlockType(0.0);
+                VectorBlockType bweights;
+                if (transpose) {
+                    diag_block.solve(bweights, rhs);
+                } else {
+                    auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
+                    diag_block_transpose.solve(bweights, rhs);
                 }
+                double abs_max = *std::max_element(
+                    bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
+                bweights /= std::fabs(abs_max);
+                weights[row] = bweights;
             }
-            VectorBlockType bweights;
-            if (transpose) {
-                diag_block.solve(bweights, rhs);
-            } else {
-                auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                exception = std::current_exception();
             }
-            double abs_max = *std::max_element(
-                bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
-            bweights /= std::fabs(abs_max);
-            weights[i.index()] = bweights;
         }
+        if (exception)
+            std::rethrow_exception(exception);
         // return weights;
     }
 
@@ -83,46 +106,82 @@ namespace Amg
         return weights;
     }
 
-    template<class Vector, class GridView, class ElementContext, class Model>
-    void getTrueImpesWeights(int pressureVarIndex, Vector& weights, const GridView& gridView,
-                             ElementContext& elemCtx, const Model& model, std::size_t threadId)
+    /// Compute the true-IMPES weights of the element the context is
+    /// currently bound to from the derivatives of its storage term.
+    template<class VectorBlockType, class MatrixBlockType, class ElementContext, class LocalResidual>
+    VectorBlockType getTrueImpesWeightsBlock(int pressureVarIndex, ElementContext& elemCtx,
+                                             const LocalResidual& localResidual)
     {
-        using VectorBlockType = typename Vector::block_type;
-        using Matrix = typename std::decay_t<decltype(model.linearizer().jacobian())>;
-        using MatrixBlockType = typename Matrix::MatrixBlock;
-        constexpr int numEq = VectorBlockType::size();
-        using Evaluation = typename std::decay_t<decltype(model.localLinearizer(threadId).localResidual().residual(0))>
-            ::block_type;
+        constexpr int numEq = VectorBlockType::dimension;
+        using Evaluation = typename std::decay_t<decltype(localResidual.residual(0))>::block_type;
         VectorBlockType rhs(0.0);
         rhs[pressureVarIndex] = 1.0;
-        int index = 0;
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            elemCtx.updatePrimaryStencil(*elemIt);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            Dune::FieldVector<Evaluation, numEq> storage;
-            model.localLinearizer(threadId).localResidual().computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
-            auto extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
-            auto scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
-            auto storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
-            MatrixBlockType block;
-            double pressure_scale = 50e5;
-            for (int ii = 0; ii < numEq; ++ii) {
-                for (int jj = 0; jj < numEq; ++jj) {
-                    block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
-                    if (jj == pressureVarIndex) {
-                        block[ii][jj] *= pressure_scale;
-                    }
+        Dune::FieldVector<Evaluation, numEq> storage;
+        localResidual.computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
+        auto extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
+        auto scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
+        auto storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
+        MatrixBlockType block;
+        double pressure_scale = 50e5;
+        for (int ii = 0; ii < numEq; ++ii) {
+            for (int jj = 0; jj < numEq; ++jj) {
+                block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
+                if (jj == pressureVarIndex) {
+                    block[ii][jj] *= pressure_scale;
+                }
+            }
+        }
+        VectorBlockType bweights;
+        MatrixBlockType block_transpose = Details::transposeDenseMatrix(block);
+        block_transpose.solve(bweights, rhs);
+        bweights /= 1000.0; // given normal densities this scales weights to about 1.
+        return bweights;
+    }
+
+    /// Compute the true-IMPES weights of all elements.
+    ///
+    /// The elements are distributed over all threads, each thread uses
+    /// its own element context and local linearizer.
+    template<class ElementContext, class Vector, class Simulator>
+    void getTrueImpesWeights(int pressureVarIndex, Vector& weights, const Simulator& simulator)
+    {
+        using VectorBlockType = typename Vector::block_type;
+        using Matrix = typename std::decay_t<decltype(simulator.model().linearizer().jacobian())>;
+        using MatrixBlockType = typename Matrix::MatrixBlock;
+        using GridView = std::decay_t<decltype(simulator.gridView())>;
+        const auto& model = simulator.model();
+        Opm::ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(simulator.gridView());
+        std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+#ifdef _OPENMP
+            const std::size_t threadId = omp_get_thread_num();
+#else
+            const std::size_t threadId = 0;
+#endif
+            ElementContext elemCtx(simulator);
+            const auto& localResidual = model.localLinearizer(threadId).localResidual();
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                try {
+                    elemCtx.updatePrimaryStencil(*elemIt);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    const unsigned globalIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                    weights[globalIdx] =
+                        getTrueImpesWeightsBlock<VectorBlockType, MatrixBlockType>(pressureVarIndex, elemCtx, localResidual);
+                }
+                catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    exception = std::current_exception();
                 }
             }
-            VectorBlockType bweights;
-            MatrixBlockType block_transpose = Details::transposeDenseMatrix(block);
-            block_transpose.solve(bweights, rhs);
-            bweights /= 1000.0; // given normal densities this scales weights to about 1.
-            weights[index] = bweights;
-            ++index;
         }
+        if (exception)
+            std::rethrow_exception(exception);
     }
 } // namespace Amg
 
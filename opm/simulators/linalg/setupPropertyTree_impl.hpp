@@ -69,7 +69,7 @@ setupPropertyTree(const FlowLinearSolverParameters& p)
             else
                 prm.put("maxiter", 20); // Use our own default.
             prm.put("verbosity", p.linear_solver_verbosity_);
-            prm.put("solver", "bicgstab");
+            prm.put("solver", p.use_pipelined_bicgstab_ ? "pipelinedbicgstab" : "bicgstab");
             prm.put("preconditioner.type", "cpr");
             prm.put("preconditioner.weight_filename", "cpr_weights.txt");
             prm.put("preconditioner.weight_type","quasiimpes");
@@ -87,7 +87,9 @@ setupPropertyTree(const FlowLinearSolverParameters& p)
             if (EWOMS_PARAM_IS_SET(TypeTag, int, CprMaxEllIter))
                 prm.put("preconditioner.coarsesolver.preconditioner.iterations", p.cpr_max_ell_iter_);
             prm.put("preconditioner.coarsesolver.preconditioner.iterations",1);
-            prm.put("preconditioner.coarsesolver.preconditioner.coarsenTarget",1200);
+            prm.put("preconditioner.coarsesolver.preconditioner.coarsenTarget", p.cpr_coarsen_target_);
+            prm.put("preconditioner.coarsesolver.preconditioner.accumulate",
+                    EWOMS_GET_PARAM(TypeTag, std::string, CprAccumulate));
             prm.put("preconditioner.coarsesolver.preconditioner.pre_smooth",1);
             prm.put("preconditioner.coarsesolver.preconditioner.post_smooth",1);
             prm.put("preconditioner.coarsesolver.preconditioner.beta",1e-5);
@@ -106,7 +108,7 @@ setupPropertyTree(const FlowLinearSolverParameters& p)
             prm.put("tol", p.linear_solver_reduction_);
             prm.put("maxiter", p.linear_solver_maxiter_);
             prm.put("verbosity", p.linear_solver_verbosity_);
-            prm.put("solver", "bicgstab");
+            prm.put("solver", p.use_pipelined_bicgstab_ ? "pipelinedbicgstab" : "bicgstab");
             prm.put("preconditioner.type", "ParOverILU0");
             prm.put("preconditioner.relaxation", p.ilu_relaxation_);
             prm.put("preconditioner.ilulevel", p.ilu_fillin_level_);
@@ -23,6 +23,7 @@
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <ostream>
 #include <sstream>
@@ -43,6 +44,10 @@ namespace Opm
           total_linearizations( 0 ),
           total_newton_iterations( 0 ),
           total_linear_iterations( 0 ),
+          total_local_newton_iterations( 0 ),
+          local_solve_time(0.0),
+          total_residual_evaluations(0),
+          residual_assemble_time(0.0),
           converged(false),
           exit_status(EXIT_SUCCESS),
           global_time(0),
@@ -65,6 +70,16 @@ namespace Opm
         total_linearizations += sr.total_linearizations;
         total_newton_iterations += sr.total_newton_iterations;
         total_linear_iterations += sr.total_linear_iterations;
+        total_local_newton_iterations += sr.total_local_newton_iterations;
+        if (domain_newton_iterations.size() < sr.domain_newton_iterations.size()) {
+            domain_newton_iterations.resize(sr.domain_newton_iterations.size(), 0);
+        }
+        for (size_t i = 0; i < sr.domain_newton_iterations.size(); ++i) {
+            domain_newton_iterations[i] += sr.domain_newton_iterations[i];
+        }
+        local_solve_time += sr.local_solve_time;
+        total_residual_evaluations += sr.total_residual_evaluations;
+        residual_assemble_time += sr.residual_assemble_time;
         global_time = sr.global_time; // It makes no sense adding time points, so = not += here.
     }
 
@@ -80,6 +95,13 @@ namespace Opm
            << " ("  << std::fixed << std::setprecision(3) << std::setw(6) << assemble_time << " sec), "
            << "linear its = " << std::setw(3) << total_linear_iterations
            << " ("  << std::fixed << std::setprecision(3) << std::setw(6) << linear_solve_time << " sec)";
+        if (total_local_newton_iterations != 0) {
+            const auto maxDomain = std::max_element(domain_newton_iterations.begin(),
+                                                    domain_newton_iterations.end());
+            ss << ", local newton its = " << std::setw(3) << total_local_newton_iterations
+               << " (max " << *maxDomain << " in domain " << maxDomain - domain_newton_iterations.begin()
+               << ", "  << std::fixed << std::setprecision(3) << std::setw(6) << local_solve_time << " sec)";
+        }
     }
 
     void SimulatorReportSingle::reportFullyImplicit(std::ostream& os, const SimulatorReportSingle* failureReport) const
@@ -101,6 +123,23 @@ namespace Opm
             }
             os << std::endl;
 
+            const unsigned int residuals = total_residual_evaluations
+                + (failureReport ? failureReport->total_residual_evaluations : 0);
+            if (residuals > 0) {
+                // compare the average cost of an assembly which only evaluates the
+                // residual with the one of a full linearization
+                const unsigned int linearizations = total_linearizations
+                    + (failureReport ? failureReport->total_linearizations : 0) - residuals;
+                const double residualTime = residual_assemble_time
+                    + (failureReport ? failureReport->residual_assemble_time : 0.0);
+                os << "  Residual only (seconds):    " << residualTime
+                   << " (" << residualTime/residuals << " per evaluation";
+                if (linearizations > 0) {
+                    os << ", full linearization " << (t - residualTime)/linearizations;
+                }
+                os << ")" << std::endl;
+            }
+
             t = linear_solve_time + (failureReport ? failureReport->linear_solve_time : 0.0);
             os << " Linear solve time (seconds): " << t;
             if (failureReport) {
@@ -125,6 +164,16 @@ namespace Opm
             }
             os << std::endl;
 
+            t = local_solve_time + (failureReport ? failureReport->local_solve_time : 0.0);
+            if (t > 0.0) {
+                os << " Local solve time (seconds):  " << t;
+                if (failureReport) {
+                    os << " (Failed: " << failureReport->local_solve_time << "; "
+                       << 100*failureReport->local_solve_time/t << "%)";
+                }
+                os << std::endl;
+            }
+
             t = output_write_time + (failureReport ? failureReport->output_write_time : 0.0);
             os << " Output write time (seconds): " << t;
             os << std::endl;
@@ -162,6 +211,16 @@ namespace Opm
                << 100.0*failureReport->total_linear_iterations/n << "%)";
         }
         os << std::endl;
+
+        n = total_local_newton_iterations + (failureReport ? failureReport->total_local_newton_iterations : 0);
+        if (n > 0) {
+            os << "Overall Local Newton Its:     " << n;
+            if (failureReport) {
+                os << " (Failed: " << failureReport->total_local_newton_iterations << "; "
+                   << 100.0*failureReport->total_local_newton_iterations/n << "%)";
+            }
+            os << std::endl;
+        }
     }
 
     void SimulatorReport::operator+=(const SimulatorReportSingle& sr)
@@ -43,6 +43,16 @@ namespace Opm
         unsigned int total_linearizations;
         unsigned int total_newton_iterations;
         unsigned int total_linear_iterations;
+        unsigned int total_local_newton_iterations;
+
+        /// Newton iterations of the local solves of each subdomain.
+        std::vector<unsigned int> domain_newton_iterations;
+        double local_solve_time;
+
+        /// Assemblies which only evaluated the residual (chord iterations),
+        /// they are included in total_linearizations and assemble_time.
+        unsigned int total_residual_evaluations;
+        double residual_assemble_time;
 
         bool converged;
         int exit_status;
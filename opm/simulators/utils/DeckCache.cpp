@@ -0,0 +1,293 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/DeckCache.hpp>
+
+#include <opm/common/utility/FileSystem.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/simulators/utils/moduleVersion.hpp>
+
+#include <ebos/eclmpiserializer.hh>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <unistd.h>
+
+namespace {
+
+const std::string cacheMagic = "OPM-DECK-CACHE-1";
+
+//! \brief 64 bit FNV-1a hash, good enough to detect modified input files.
+class ContentHash {
+public:
+    void add(const char* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            m_hash ^= static_cast<unsigned char>(data[i]);
+            m_hash *= 1099511628211ULL;
+        }
+        m_bytes += size;
+    }
+
+    void add(const std::string& data)
+    {
+        add(data.data(), data.size());
+    }
+
+    std::string str() const
+    {
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << m_hash
+           << '-' << std::dec << m_bytes;
+        return os.str();
+    }
+
+private:
+    std::uint64_t m_hash = 14695981039346656037ULL;
+    std::size_t m_bytes = 0;
+};
+
+std::string readFile(const Opm::filesystem::path& fileName)
+{
+    std::ifstream is(fileName.string(), std::ios::binary);
+    if (!is)
+        throw std::runtime_error("Could not open '" + fileName.string() + "'");
+
+    std::ostringstream content;
+    content << is.rdbuf();
+    return content.str();
+}
+
+//! \brief Extracts the file name from the record following INCLUDE, IMPORT or GDFILE.
+std::string recordFileName(const std::string& line)
+{
+    if (line[0] == '\'' || line[0] == '"') {
+        const auto end = line.find(line[0], 1);
+        return line.substr(1, end == std::string::npos ? std::string::npos : end - 1);
+    }
+
+    const auto end = line.find_first_of(" \t/");
+    return line.substr(0, end);
+}
+
+//! \brief Adds a deck file and all files it refers to to the hash.
+//! \return False if a referenced file could not be resolved
+bool hashDeckFile(const Opm::filesystem::path& fileName,
+                  const Opm::filesystem::path& rootDir,
+                  ContentHash& hash)
+{
+    const std::string content = readFile(fileName);
+    hash.add(fileName.string());
+    hash.add(content);
+
+    std::istringstream is(content);
+    std::string line;
+    std::string pendingKeyword;
+    while (std::getline(is, line)) {
+        const auto comment = line.find("--");
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        const auto begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos)
+            continue;
+        line = line.substr(begin);
+
+        if (pendingKeyword.empty()) {
+            std::string keyword = line.substr(0, line.find_first_of(" \t\r/"));
+            std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::toupper);
+            if (keyword == "INCLUDE" || keyword == "IMPORT" || keyword == "GDFILE")
+                pendingKeyword = keyword;
+            continue;
+        }
+
+        const std::string recordName = recordFileName(line);
+        // PATHS aliases are not resolved here, so we can not tell whether
+        // the referenced file has changed.
+        if (recordName.empty() || recordName.find('$') != std::string::npos)
+            return false;
+
+        Opm::filesystem::path includeFile(recordName);
+        if (includeFile.is_relative())
+            includeFile = rootDir / includeFile;
+
+        if (!Opm::filesystem::exists(includeFile))
+            return false;
+
+        if (pendingKeyword == "INCLUDE") {
+            if (!hashDeckFile(includeFile, rootDir, hash))
+                return false;
+        }
+        else {
+            hash.add(includeFile.string());
+            hash.add(readFile(includeFile));
+        }
+
+        pendingKeyword.clear();
+    }
+
+    return true;
+}
+
+void writeString(std::ostream& os, const std::string& str)
+{
+    const std::size_t size = str.size();
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    os.write(str.data(), size);
+}
+
+bool readString(std::istream& is, std::string& str)
+{
+    std::size_t size = 0;
+    if (!is.read(reinterpret_cast<char*>(&size), sizeof(size)))
+        return false;
+    str.resize(size);
+    return static_cast<bool>(is.read(&str[0], size));
+}
+
+//! \brief Serializer which can store its buffer in a stream.
+class DeckCacheSerializer : public Opm::EclMpiSerializer {
+public:
+    DeckCacheSerializer()
+        : Opm::EclMpiSerializer(Dune::MPIHelper::getCollectiveCommunication())
+    {}
+
+    template<class T>
+    void write(std::ostream& os, T& data)
+    {
+        pack(data);
+        const std::size_t size = m_position;
+        os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        os.write(m_buffer.data(), size);
+    }
+
+    template<class T>
+    bool read(std::istream& is, T& data)
+    {
+        std::size_t size = 0;
+        if (!is.read(reinterpret_cast<char*>(&size), sizeof(size)))
+            return false;
+        m_buffer.resize(size);
+        if (!is.read(m_buffer.data(), size))
+            return false;
+        unpack(data);
+        return true;
+    }
+};
+
+}
+
+namespace Opm {
+
+std::string deckCacheKey(const std::string& deckFilename,
+                         const ParseContext& parseContext)
+{
+    const Opm::filesystem::path deckFile(deckFilename);
+    ContentHash hash;
+    hash.add(moduleVersion());
+
+    // A cache is only written if the deck was loaded without errors, which
+    // depends on how strictly it was parsed.
+    for (const auto& [errorKey, action] : parseContext) {
+        hash.add(errorKey);
+        hash.add(std::to_string(static_cast<int>(action)));
+    }
+
+    if (!hashDeckFile(deckFile, deckFile.parent_path(), hash))
+        return std::string();
+
+    return hash.str();
+}
+
+bool loadDeckCache(const std::string& cacheFilename, const std::string& key,
+                   Schedule& schedule, SummaryConfig& summaryConfig,
+                   double& setupTime)
+{
+    std::ifstream is(cacheFilename, std::ios::binary);
+    if (!is)
+        return false;
+
+    std::string magic, cachedKey;
+    if (!readString(is, magic) || magic != cacheMagic)
+        return false;
+    if (!readString(is, cachedKey) || cachedKey != key)
+        return false;
+    if (!is.read(reinterpret_cast<char*>(&setupTime), sizeof(setupTime)))
+        return false;
+
+    DeckCacheSerializer ser;
+    return ser.read(is, schedule) && ser.read(is, summaryConfig);
+}
+
+void writeDeckCache(const std::string& cacheFilename, const std::string& key,
+                    Schedule& schedule, SummaryConfig& summaryConfig,
+                    double setupTime)
+{
+    // write to a temporary file first, concurrent runs of the same deck
+    // must never see a partially written cache. Runs sharing a cache
+    // directory each use their own temporary file.
+    std::ostringstream tmpName;
+    tmpName << cacheFilename << ".tmp." << ::getpid()
+            << '.' << Dune::MPIHelper::getCollectiveCommunication().rank()
+            << '.' << std::hex << std::random_device{}();
+    const std::string tmpFilename = tmpName.str();
+    try {
+        {
+            std::ofstream os(tmpFilename, std::ios::binary);
+            if (!os)
+                throw std::runtime_error("Could not open deck cache '" + tmpFilename + "' for writing");
+
+            writeString(os, cacheMagic);
+            writeString(os, key);
+            os.write(reinterpret_cast<const char*>(&setupTime), sizeof(setupTime));
+
+            DeckCacheSerializer ser;
+            ser.write(os, schedule);
+            ser.write(os, summaryConfig);
+            if (!os)
+                throw std::runtime_error("Failed to write deck cache '" + tmpFilename + "'");
+        }
+
+        std::error_code ec;
+        Opm::filesystem::rename(tmpFilename, cacheFilename, ec);
+        if (ec)
+            throw std::runtime_error("Could not rename '" + tmpFilename + "' to '"
+                                     + cacheFilename + "': " + ec.message());
+    }
+    catch (...) {
+        std::error_code ec;
+        Opm::filesystem::remove(tmpFilename, ec);
+        throw;
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DECK_CACHE_HPP
+#define DECK_CACHE_HPP
+
+#include <string>
+
+namespace Opm {
+
+class ParseContext;
+class Schedule;
+class SummaryConfig;
+
+/*! \brief Computes a key identifying the content of a deck.
+ *! \details The key is a hash of the deck file, all files it includes
+ *!          (recursively), the actions of the parse context and the
+ *!          simulator version. An empty string is returned if an include
+ *!          file can not be resolved, e.g. because it refers to a PATHS
+ *!          alias.
+ *! \param deckFilename Name of the top-level deck file
+ *! \param parseContext The settings the deck is parsed with
+*/
+std::string deckCacheKey(const std::string& deckFilename,
+                         const ParseContext& parseContext);
+
+/*! \brief Loads a serialized schedule and summary config from a cache file.
+ *! \details Nothing is loaded if the file does not exist or if it was
+ *!          written for a different key. Only the schedule and summary
+ *!          config are cached; the deck must still be parsed and the
+ *!          EclipseState created, since their root-only data (input grid
+ *!          and global field properties) is not serialized.
+ *! \param cacheFilename Name of cache file
+ *! \param key Key of the current deck, see deckCacheKey()
+ *! \param schedule Schedule to load into
+ *! \param summaryConfig SummaryConfig to load into
+ *! \param setupTime Set to the time it took to create the cached objects
+ *! \return True if the objects were loaded from the cache
+*/
+bool loadDeckCache(const std::string& cacheFilename, const std::string& key,
+                   Schedule& schedule, SummaryConfig& summaryConfig,
+                   double& setupTime);
+
+/*! \brief Writes a serialized schedule and summary config to a cache file.
+ *! \details The cache is written to a temporary file with a unique name
+ *!          first, which is then renamed. Concurrent runs sharing a cache
+ *!          therefore never see a partially written file.
+ *! \throws std::runtime_error if the cache could not be written
+ *! \param cacheFilename Name of cache file
+ *! \param key Key of the current deck, see deckCacheKey()
+ *! \param schedule Schedule to store
+ *! \param summaryConfig SummaryConfig to store
+ *! \param setupTime The time it took to create the objects
+*/
+void writeDeckCache(const std::string& cacheFilename, const std::string& key,
+                    Schedule& schedule, SummaryConfig& summaryConfig,
+                    double setupTime);
+
+} // end namespace Opm
+
+#endif // DECK_CACHE_HPP
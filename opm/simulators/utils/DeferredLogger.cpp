@@ -20,9 +20,99 @@
 
 #include <opm/simulators/utils/DeferredLogger.hpp>
 
+#include <cassert>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace
+{
+
+    // The interned message templates of the process. The templates are
+    // stored in a deque, so references to them stay valid.
+    struct TemplateRegistry
+    {
+        std::mutex mutex;
+        std::deque<std::pair<std::string, std::string>> templates;
+        std::map<std::pair<std::string, std::string>, int> ids;
+    };
+
+    TemplateRegistry& templateRegistry()
+    {
+        static TemplateRegistry registry;
+        return registry;
+    }
+
+} // anonymous namespace
+
 namespace Opm
 {
 
+    int DeferredLogger::messageTemplate(const std::string& tag, const std::string& text)
+    {
+        auto& registry = templateRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto key = std::make_pair(tag, text);
+        const auto it = registry.ids.find(key);
+        if (it != registry.ids.end()) {
+            return it->second;
+        }
+        const int templateId = registry.templates.size();
+        registry.templates.push_back(key);
+        registry.ids.emplace(std::move(key), templateId);
+        return templateId;
+    }
+
+    const std::pair<std::string, std::string>& DeferredLogger::messageTemplate_(int templateId)
+    {
+        auto& registry = templateRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        assert(templateId >= 0 && templateId < static_cast<int>(registry.templates.size()));
+        return registry.templates[templateId];
+    }
+
+    void DeferredLogger::addArgument_(const char* value, std::size_t size)
+    {
+        arguments_.push_back({Argument::String, static_cast<std::int64_t>(chars_.size()), 0.0,
+                              static_cast<unsigned>(size)});
+        chars_.insert(chars_.end(), value, value + size);
+    }
+
+    std::string DeferredLogger::text(const Message& message) const
+    {
+        if (message.templateId < 0) {
+            return message.text;
+        }
+
+        const std::string& format = messageTemplate_(message.templateId).second;
+        std::string result;
+        result.reserve(format.size());
+        unsigned argIdx = 0;
+        std::string::size_type pos = 0;
+        while (true) {
+            const auto placeholder = format.find("{}", pos);
+            if (placeholder == std::string::npos || argIdx == message.numArguments) {
+                result.append(format, pos, std::string::npos);
+                break;
+            }
+            result.append(format, pos, placeholder - pos);
+            const auto& arg = arguments_[message.firstArgument + argIdx++];
+            switch (arg.type) {
+            case Argument::Integer:
+                result += std::to_string(arg.integer);
+                break;
+            case Argument::Float:
+                result += std::to_string(arg.floating);
+                break;
+            case Argument::String:
+                result.append(chars_.data() + arg.integer, arg.size);
+                break;
+            }
+            pos = placeholder + 2;
+        }
+        return result;
+    }
+
     void DeferredLogger::info(const std::string& tag, const std::string& message)
     {
         messages_.push_back({Log::MessageType::Info, tag, message});
@@ -84,14 +174,38 @@ namespace Opm
     void DeferredLogger::logMessages()
     {
         for (const auto& m : messages_) {
-            OpmLog::addTaggedMessage(m.flag, m.tag, m.text);
+            if (m.templateId < 0) {
+                OpmLog::addTaggedMessage(m.flag, m.tag, m.text);
+            } else {
+                OpmLog::addTaggedMessage(m.flag, messageTemplate_(m.templateId).first, text(m));
+            }
         }
-        messages_.clear();
+        clearMessages();
     }
 
     void DeferredLogger::clearMessages()
     {
         messages_.clear();
+        arguments_.clear();
+        chars_.clear();
+    }
+
+    void DeferredLogger::appendMessages(const DeferredLogger& other)
+    {
+        // the arguments of the other logger are moved behind ours
+        const unsigned argumentOffset = arguments_.size();
+        const std::int64_t charOffset = chars_.size();
+        for (auto m : other.messages_) {
+            m.firstArgument += argumentOffset;
+            messages_.push_back(std::move(m));
+        }
+        for (auto arg : other.arguments_) {
+            if (arg.type == Argument::String) {
+                arg.integer += charOffset;
+            }
+            arguments_.push_back(arg);
+        }
+        chars_.insert(chars_.end(), other.chars_.begin(), other.chars_.end());
     }
 
 } // namespace Opm
@@ -23,7 +23,11 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -31,6 +35,11 @@ namespace Opm
     /** This class implements a deferred logger:
      * 1) messages can be pushed back to a vector
      * 2) a call to logMessages adds the messages to OpmLog backends
+     *
+     * Messages which are logged often, e.g. in every Newton iteration, can
+     * use an interned message template instead of a text. Only the template
+     * id and the arguments are stored, and the text is formatted when the
+     * message is logged, i.e. on the rank which writes the log.
      * */
 
     class DeferredLogger
@@ -42,8 +51,19 @@ namespace Opm
             int64_t flag;
             std::string tag;
             std::string text;
+            // messages of a template have an empty tag and text, they refer
+            // to their arguments in the argument arena of the logger
+            int templateId = -1;
+            unsigned firstArgument = 0;
+            unsigned numArguments = 0;
         };
 
+        /// Intern a message template, i.e. a tag and a text in which each "{}"
+        /// is replaced by the next argument of the message. The same template
+        /// always gets the same id within a process, so call sites keep the id
+        /// in a function-local static.
+        static int messageTemplate(const std::string& tag, const std::string& text);
+
         void info(const std::string& tag, const std::string& message);
         void warning(const std::string& tag, const std::string& message);
         void error(const std::string& tag, const std::string& message);
@@ -60,6 +80,37 @@ namespace Opm
         void debug(const std::string& message);
         void note(const std::string& message);
 
+        /// Add a message of an interned template. The arguments may be
+        /// integers, floating point numbers, which are formatted like
+        /// std::to_string(), and strings. They are copied to the argument
+        /// arena of the logger, which keeps its capacity when the messages
+        /// are cleared.
+        template <class... Args>
+        void info(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Info, templateId, args...); }
+        template <class... Args>
+        void warning(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Warning, templateId, args...); }
+        template <class... Args>
+        void error(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Error, templateId, args...); }
+        template <class... Args>
+        void problem(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Problem, templateId, args...); }
+        template <class... Args>
+        void bug(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Bug, templateId, args...); }
+        template <class... Args>
+        void debug(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Debug, templateId, args...); }
+        template <class... Args>
+        void note(int templateId, const Args&... args)
+        { addMessage_(Log::MessageType::Note, templateId, args...); }
+
+        /// Return the text of a message, formatted from its template if it
+        /// has one.
+        std::string text(const Message& message) const;
+
         /// Log all messages to the OpmLog backends,
         /// and clear the message container.
         void logMessages();
@@ -67,8 +118,51 @@ namespace Opm
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Append all messages of another logger to the message container,
+        /// e.g. to combine the logs of several threads.
+        void appendMessages(const DeferredLogger& other);
+
     private:
+        struct Argument
+        {
+            enum Type : int { Integer, Float, String };
+            Type type;
+            // the value of an integer or the position of a string in chars_
+            std::int64_t integer;
+            double floating;
+            // the length of a string
+            unsigned size;
+        };
+
+        template <class... Args>
+        void addMessage_(int64_t flag, int templateId, const Args&... args)
+        {
+            messages_.push_back({flag, std::string(), std::string(), templateId,
+                                 static_cast<unsigned>(arguments_.size()), sizeof...(Args)});
+            (addArgument_(args), ...);
+        }
+
+        template <class T>
+        std::enable_if_t<std::is_integral<T>::value> addArgument_(const T& value)
+        { arguments_.push_back({Argument::Integer, static_cast<std::int64_t>(value), 0.0, 0}); }
+
+        template <class T>
+        std::enable_if_t<std::is_floating_point<T>::value> addArgument_(const T& value)
+        { arguments_.push_back({Argument::Float, 0, static_cast<double>(value), 0}); }
+
+        void addArgument_(const std::string& value)
+        { addArgument_(value.data(), value.size()); }
+
+        void addArgument_(const char* value)
+        { addArgument_(value, std::strlen(value)); }
+
+        void addArgument_(const char* value, std::size_t size);
+
+        static const std::pair<std::string, std::string>& messageTemplate_(int templateId);
+
         std::vector<Message> messages_;
+        std::vector<Argument> arguments_;
+        std::vector<char> chars_;
         friend Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger);
     };
 
@@ -0,0 +1,70 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/MaxSumReduction.hpp>
+
+#include <algorithm>
+
+#if HAVE_MPI
+
+namespace {
+
+// The datatype holds all values, hence MPI never splits them and the
+// first value of each element is the one to take the maximum of.
+void maxAndSums(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
+{
+    int bytes = 0;
+    MPI_Type_size(*datatype, &bytes);
+    const int size = bytes / sizeof(double);
+
+    const double* in = static_cast<const double*>(invec);
+    double* inout = static_cast<double*>(inoutvec);
+    for (int elem = 0; elem < *len; ++elem, in += size, inout += size) {
+        inout[0] = std::max(inout[0], in[0]);
+        for (int i = 1; i < size; ++i)
+            inout[i] += in[i];
+    }
+}
+
+}
+
+namespace Opm {
+
+void reduceMaxAndSums(MPI_Comm comm, std::vector<double>& values)
+{
+    if (values.empty())
+        return;
+
+    static MPI_Op op = [] {
+        MPI_Op result;
+        MPI_Op_create(&maxAndSums, /*commute=*/1, &result);
+        return result;
+    }();
+
+    MPI_Datatype type;
+    MPI_Type_contiguous(values.size(), MPI_DOUBLE, &type);
+    MPI_Type_commit(&type);
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), 1, type, op, comm);
+    MPI_Type_free(&type);
+}
+
+} // end namespace Opm
+
+#endif
@@ -0,0 +1,62 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_MAX_SUM_REDUCTION_HPP
+#define OPM_MAX_SUM_REDUCTION_HPP
+
+#include <dune/common/parallel/collectivecommunication.hh>
+
+#if HAVE_MPI
+#include <dune/common/parallel/mpicollectivecommunication.hh>
+#include <mpi.h>
+#endif
+
+#include <vector>
+
+namespace Opm {
+
+#if HAVE_MPI
+/*! \brief Replaces the first value by its maximum and the other values by
+ *!        their sums over all processes of the communicator.
+ *! \details This is done by a single allreduce with a custom operation.
+*/
+void reduceMaxAndSums(MPI_Comm comm, std::vector<double>& values);
+
+inline void reduceMaxAndSums(const Dune::CollectiveCommunication<MPI_Comm>& comm,
+                             std::vector<double>& values)
+{
+    if (comm.size() > 1)
+        reduceMaxAndSums(static_cast<MPI_Comm>(comm), values);
+}
+#endif
+
+//! \brief Fallback for other communicators, e.g. the sequential one.
+template<class Comm>
+void reduceMaxAndSums(const Comm& comm, std::vector<double>& values)
+{
+    if (values.empty())
+        return;
+
+    values[0] = comm.max(values[0]);
+    if (values.size() > 1)
+        comm.sum(values.data() + 1, values.size() - 1);
+}
+
+} // end namespace Opm
+
+#endif // OPM_MAX_SUM_REDUCTION_HPP
@@ -0,0 +1,115 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/MemoryReport.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace {
+
+double toMB(double bytes)
+{
+    return bytes / (1024.0*1024.0);
+}
+
+}
+
+namespace Opm {
+
+void MemoryReport::add(const std::string& subsystem, std::size_t bytes)
+{
+    auto entry = std::find_if(entries_.begin(), entries_.end(),
+                              [&subsystem](const Entry& e) { return e.subsystem == subsystem; });
+    if (entry == entries_.end()) {
+        entries_.push_back(Entry{subsystem, 0.0, 0.0, 0.0});
+        entry = entries_.end() - 1;
+    }
+
+    entry->bytes += bytes;
+    entry->sum = entry->bytes;
+    entry->max = entry->bytes;
+    totalSum_ += bytes;
+    totalMax_ += bytes;
+}
+
+std::size_t MemoryReport::bytes(const std::string& subsystem) const
+{
+    for (const auto& entry : entries_) {
+        if (entry.subsystem == subsystem)
+            return entry.bytes;
+    }
+    return 0;
+}
+
+std::size_t MemoryReport::totalBytes() const
+{
+    double total = 0.0;
+    for (const auto& entry : entries_)
+        total += entry.bytes;
+    return total;
+}
+
+std::string MemoryReport::str(const std::string& title) const
+{
+    std::size_t nameWidth = 18;
+    for (const auto& entry : entries_)
+        nameWidth = std::max(nameWidth, entry.subsystem.size());
+
+    std::ostringstream os;
+    os << title << " [MB]\n" << std::fixed << std::setprecision(1);
+    const auto line = [&os, nameWidth, this](const std::string& name, double sum, double max) {
+        os << "  " << std::left << std::setw(nameWidth) << name << std::right
+           << std::setw(12) << toMB(sum);
+        if (numProcesses_ > 1)
+            os << std::setw(12) << toMB(max);
+        os << '\n';
+    };
+
+    if (numProcesses_ > 1) {
+        os << "  " << std::left << std::setw(nameWidth) << "" << std::right
+           << std::setw(12) << "total" << std::setw(12) << "max/process" << '\n';
+    }
+    for (const auto& entry : entries_)
+        line(entry.subsystem, entry.sum, entry.max);
+    line("Accounted", totalSum_, totalMax_);
+    if (residentMax_ > 0.0)
+        line("Resident set", residentSum_, residentMax_);
+
+    return os.str();
+}
+
+std::size_t MemoryReport::residentMemory()
+{
+    // the second field of statm is the number of resident pages
+    std::ifstream statm("/proc/self/statm");
+    std::size_t sizePages = 0;
+    std::size_t residentPages = 0;
+    if (!(statm >> sizePages >> residentPages))
+        return 0;
+
+    return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // end namespace Opm
@@ -0,0 +1,135 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef MEMORY_REPORT_HPP
+#define MEMORY_REPORT_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Opm {
+
+/*! \brief The memory held by the subsystems of the simulator.
+ *! \details The bytes of a subsystem are counted from the sizes of its
+ *!          containers, so they are a lower bound of what the allocator
+ *!          actually reserved for it. The resident set of the process is
+ *!          reported alongside for comparison.
+*/
+class MemoryReport
+{
+public:
+    /*! \brief Adds bytes to a subsystem, which is created on first use.
+     *! \details The subsystems are reported in the order of their creation,
+     *!          which must be the same on all processes for reduce().
+    */
+    void add(const std::string& subsystem, std::size_t bytes);
+
+    //! \brief Returns the bytes of a subsystem on this process.
+    std::size_t bytes(const std::string& subsystem) const;
+
+    //! \brief Returns the bytes of all subsystems on this process.
+    std::size_t totalBytes() const;
+
+    /*! \brief Computes the sum over all processes and the maximum of a
+     *!        single process for each subsystem.
+    */
+    template<class Comm>
+    void reduce(const Comm& comm)
+    {
+        std::vector<double> sum;
+        for (const auto& entry : entries_)
+            sum.push_back(entry.bytes);
+        sum.push_back(totalBytes());
+        sum.push_back(residentBytes_);
+        std::vector<double> max(sum);
+        comm.sum(sum.data(), sum.size());
+        comm.max(max.data(), max.size());
+
+        for (std::size_t entryIdx = 0; entryIdx < entries_.size(); ++entryIdx) {
+            entries_[entryIdx].sum = sum[entryIdx];
+            entries_[entryIdx].max = max[entryIdx];
+        }
+        totalSum_ = sum[entries_.size()];
+        totalMax_ = max[entries_.size()];
+        residentSum_ = sum.back();
+        residentMax_ = max.back();
+        numProcesses_ = comm.size();
+    }
+
+    //! \brief Returns a table of the subsystems in MB headed by the title.
+    std::string str(const std::string& title) const;
+
+    //! \brief Returns the resident set size of the process, 0 if unknown.
+    static std::size_t residentMemory();
+
+private:
+    struct Entry
+    {
+        std::string subsystem;
+        double bytes;
+        double sum;
+        double max;
+    };
+
+    std::vector<Entry> entries_;
+    double totalSum_ = 0.0;
+    double totalMax_ = 0.0;
+    double residentBytes_ = residentMemory();
+    double residentSum_ = residentBytes_;
+    double residentMax_ = residentBytes_;
+    int numProcesses_ = 1;
+};
+
+template<class T, class Alloc>
+std::size_t memoryUsageOf(const std::vector<T, Alloc>& data)
+{ return data.capacity() * sizeof(T); }
+
+template<class Alloc>
+std::size_t memoryUsageOf(const std::vector<bool, Alloc>& data)
+{ return data.capacity() / 8; }
+
+//! \brief Estimate assuming one node per element and one pointer per bucket.
+template<class Key, class T, class Hash, class Equal, class Alloc>
+std::size_t memoryUsageOf(const std::unordered_map<Key, T, Hash, Equal, Alloc>& data)
+{
+    using Value = typename std::unordered_map<Key, T, Hash, Equal, Alloc>::value_type;
+    return data.size() * (sizeof(Value) + 2*sizeof(void*)) + data.bucket_count() * sizeof(void*);
+}
+
+//! \brief Estimate assuming red-black tree nodes of three pointers and a color.
+template<class Key, class T, class Compare, class Alloc>
+std::size_t memoryUsageOf(const std::map<Key, T, Compare, Alloc>& data)
+{
+    using Value = typename std::map<Key, T, Compare, Alloc>::value_type;
+    return data.size() * (sizeof(Value) + 4*sizeof(void*));
+}
+
+//! \brief Bytes of the blocks, column indices and rows of a BCRSMatrix.
+template<class Matrix>
+std::size_t matrixMemoryUsage(const Matrix& matrix)
+{
+    return matrix.nonzeroes() * (sizeof(typename Matrix::block_type) + sizeof(typename Matrix::size_type))
+        + matrix.N() * sizeof(typename Matrix::row_type);
+}
+
+} // end namespace Opm
+
+#endif // MEMORY_REPORT_HPP
@@ -0,0 +1,188 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/RankCheckpoint.hpp>
+
+#include <opm/common/utility/FileSystem.hpp>
+#include <opm/simulators/utils/ParallelRestart.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+const std::string checkpointMagic = "OPM-RANK-CHECKPOINT-1";
+
+template<class T>
+void writeValue(std::ostream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<class T>
+bool readValue(std::istream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template<class T>
+void writeVector(std::ostream& os, const std::vector<T>& data)
+{
+    writeValue(os, data.size());
+    os.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+template<class T>
+bool readVector(std::istream& is, std::vector<T>& data)
+{
+    std::size_t size = 0;
+    if (!readValue(is, size))
+        return false;
+    data.resize(size);
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(data.data()), size * sizeof(T)));
+}
+
+}
+
+namespace Opm {
+
+std::string rankCheckpointFileName(const std::string& caseName, int reportStep, int rank)
+{
+    std::ostringstream os;
+    os << caseName << '.' << std::setw(4) << std::setfill('0') << reportStep
+       << '.' << std::setw(5) << std::setfill('0') << rank << ".OPMCHK";
+    return os.str();
+}
+
+void writeRankCheckpoint(const std::string& fileName, const RankCheckpoint& checkpoint)
+{
+    std::vector<char> buffer(Mpi::packSize(checkpoint.restartValue, MPI_COMM_SELF));
+    int position = 0;
+    Mpi::pack(checkpoint.restartValue, buffer, position, MPI_COMM_SELF);
+    buffer.resize(position);
+
+    const std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream os(tmpFileName, std::ios::binary);
+        if (!os)
+            throw std::runtime_error("Could not open checkpoint file '" + tmpFileName + "' for writing");
+
+        writeVector(os, std::vector<char>(checkpointMagic.begin(), checkpointMagic.end()));
+        writeValue(os, checkpoint.reportStep);
+        writeValue(os, checkpoint.rank);
+        writeValue(os, checkpoint.numRanks);
+        writeVector(os, checkpoint.globalIndex);
+        writeVector(os, checkpoint.interior);
+        writeVector(os, buffer);
+        writeVector(os, checkpoint.summaryState);
+        if (!os)
+            throw std::runtime_error("Failed to write checkpoint file '" + tmpFileName + "'");
+    }
+
+    Opm::filesystem::rename(tmpFileName, fileName);
+}
+
+bool readRankCheckpoint(const std::string& fileName, RankCheckpoint& checkpoint)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    if (!is)
+        return false;
+
+    std::vector<char> magic;
+    if (!readVector(is, magic) || std::string(magic.begin(), magic.end()) != checkpointMagic)
+        return false;
+
+    std::vector<char> buffer;
+    if (!readValue(is, checkpoint.reportStep) ||
+        !readValue(is, checkpoint.rank) ||
+        !readValue(is, checkpoint.numRanks) ||
+        !readVector(is, checkpoint.globalIndex) ||
+        !readVector(is, checkpoint.interior) ||
+        !readVector(is, buffer) ||
+        !readVector(is, checkpoint.summaryState))
+        return false;
+
+    if (checkpoint.globalIndex.size() != checkpoint.interior.size())
+        return false;
+
+    int position = 0;
+    Mpi::unpack(checkpoint.restartValue, buffer, position, MPI_COMM_SELF);
+    return true;
+}
+
+bool mergeRankCheckpoints(const std::string& caseName, int reportStep,
+                          std::size_t numGlobalCells, RankCheckpoint& merged)
+{
+    RankCheckpoint first;
+    if (!readRankCheckpoint(rankCheckpointFileName(caseName, reportStep, 0), first))
+        return false;
+
+    const int numRanks = first.numRanks;
+    merged = RankCheckpoint();
+    merged.reportStep = reportStep;
+    merged.globalIndex.resize(numGlobalCells);
+    merged.interior.assign(numGlobalCells, 1);
+    for (std::size_t cellIdx = 0; cellIdx < numGlobalCells; ++cellIdx)
+        merged.globalIndex[cellIdx] = cellIdx;
+    merged.restartValue.extra = first.restartValue.extra;
+    merged.summaryState = first.summaryState;
+
+    auto& solution = merged.restartValue.solution;
+    for (const auto& entry : first.restartValue.solution)
+        solution.insert(entry.first, entry.second.dim,
+                        std::vector<double>(numGlobalCells, 0.0), entry.second.target);
+
+    for (int rank = 0; rank < numRanks; ++rank) {
+        RankCheckpoint checkpoint;
+        if (rank == 0)
+            checkpoint = std::move(first);
+        else if (!readRankCheckpoint(rankCheckpointFileName(caseName, reportStep, rank), checkpoint))
+            return false;
+
+        if (checkpoint.numRanks != numRanks || checkpoint.reportStep != reportStep)
+            return false;
+
+        for (const auto& entry : checkpoint.restartValue.solution) {
+            if (!solution.has(entry.first) ||
+                entry.second.data.size() != checkpoint.globalIndex.size())
+                return false;
+
+            auto& globalData = solution.at(entry.first).data;
+            for (std::size_t localIdx = 0; localIdx < checkpoint.globalIndex.size(); ++localIdx) {
+                if (!checkpoint.interior[localIdx])
+                    continue;
+                const auto globalIdx = static_cast<std::size_t>(checkpoint.globalIndex[localIdx]);
+                if (globalIdx >= numGlobalCells)
+                    return false;
+                globalData[globalIdx] = entry.second.data[localIdx];
+            }
+        }
+
+        for (const auto& well : checkpoint.restartValue.wells)
+            merged.restartValue.wells.insert(well);
+    }
+
+    return true;
+}
+
+} // end namespace Opm
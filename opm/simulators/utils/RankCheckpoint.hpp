@@ -0,0 +1,80 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef RANK_CHECKPOINT_HPP
+#define RANK_CHECKPOINT_HPP
+
+#include <opm/output/eclipse/RestartValue.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*! \brief The restart data of one process at one report step.
+ *! \details The solution is stored for the cells of the process, in the
+ *!          order of the local grid. The index maps each local cell to its
+ *!          global (active) cell index, cells owned by other processes are
+ *!          flagged so only one value is used per cell when merging.
+*/
+struct RankCheckpoint
+{
+    int reportStep = 0;
+    int rank = 0;
+    int numRanks = 1;
+    std::vector<int> globalIndex; //!< Global cell index of each local cell
+    std::vector<char> interior; //!< 1 if the local cell is owned by the process
+    RestartValue restartValue{data::Solution{}, data::Wells{}};
+    std::vector<char> summaryState; //!< Serialized SummaryState
+};
+
+/*! \brief Returns the name of the checkpoint file of a process.
+ *! \param caseName Output directory and base name of the case
+ *! \param reportStep Report step of the checkpoint
+ *! \param rank Rank of the process
+*/
+std::string rankCheckpointFileName(const std::string& caseName, int reportStep, int rank);
+
+/*! \brief Writes the checkpoint of a process to a file.
+ *! \details The file is written to a temporary name first and then renamed,
+ *!          so an interrupted run never leaves a partial checkpoint.
+*/
+void writeRankCheckpoint(const std::string& fileName, const RankCheckpoint& checkpoint);
+
+/*! \brief Reads the checkpoint of a process.
+ *! \return False if the file does not exist or is not a checkpoint file
+*/
+bool readRankCheckpoint(const std::string& fileName, RankCheckpoint& checkpoint);
+
+/*! \brief Merges the checkpoints of all processes into the global restart data.
+ *! \details The solution of the result is indexed by global cell index,
+ *!          the wells are the union of the wells of all processes and the
+ *!          extra data and the summary state are taken from rank 0.
+ *! \param caseName Output directory and base name of the case
+ *! \param reportStep Report step of the checkpoints
+ *! \param numGlobalCells Number of active cells of the global grid
+ *! \param merged Set to the merged data
+ *! \return False if the checkpoint of any process could not be read
+*/
+bool mergeRankCheckpoints(const std::string& caseName, int reportStep,
+                          std::size_t numGlobalCells, RankCheckpoint& merged);
+
+} // end namespace Opm
+
+#endif // RANK_CHECKPOINT_HPP
@@ -0,0 +1,220 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_REGION_AGGREGATOR_HPP
+#define OPM_REGION_AGGREGATOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Opm {
+
+/*! \brief Sums per-cell quantities over the regions of a region set.
+ *! \details The cells of each region are stored contiguously (in CSR
+ *!          form), so all quantities of a region set are summed in a
+ *!          single pass over the cells. Each thread sums into its own
+ *!          partial sums and the totals of all regions and quantities are
+ *!          communicated by a single reduction.
+*/
+class RegionAggregator
+{
+public:
+    RegionAggregator() = default;
+
+    /*! \brief Creates the cell lists of the regions.
+     *! \param cellRegion Zero-based region of each cell. Cells with a
+     *!                   negative region, e.g. the ones which are not
+     *!                   owned by this process, are not summed.
+     *! \param comm       The number of regions is the maximum over all
+     *!                   processes of this communicator.
+    */
+    template<class Comm>
+    RegionAggregator(const std::vector<int>& cellRegion, const Comm& comm)
+        : cellRegion_(cellRegion)
+    {
+        int localNumRegions = 0;
+        for (const int region : cellRegion_)
+            localNumRegions = std::max(localNumRegions, region + 1);
+        numRegions_ = comm.max(localNumRegions);
+
+        regionStart_.assign(numRegions_ + 1, 0);
+        for (const int region : cellRegion_) {
+            if (region >= 0)
+                ++regionStart_[region + 1];
+        }
+        for (std::size_t region = 0; region < numRegions_; ++region)
+            regionStart_[region + 1] += regionStart_[region];
+
+        cells_.resize(regionStart_.back());
+        std::vector<std::size_t> pos(regionStart_.begin(), regionStart_.end() - 1);
+        for (std::size_t cellIdx = 0; cellIdx < cellRegion_.size(); ++cellIdx) {
+            const int region = cellRegion_[cellIdx];
+            if (region >= 0)
+                cells_[pos[region]++] = cellIdx;
+        }
+    }
+
+    //! \brief Returns the number of regions of all processes.
+    std::size_t numRegions() const
+    { return numRegions_; }
+
+    //! \brief Returns the region of a cell, negative if it is not summed.
+    int region(std::size_t cellIdx) const
+    { return cellRegion_[cellIdx]; }
+
+    //! \brief Returns the number of cells in the cell lists of all regions.
+    std::size_t numEntries() const
+    { return cells_.size(); }
+
+    /*! \brief Returns a cell of the cell lists.
+     *! \details The cells of each region are contiguous, the regions are in
+     *!          ascending order.
+    */
+    std::size_t cell(std::size_t entryIdx) const
+    { return cells_[entryIdx]; }
+
+    /*! \brief Sums per-cell arrays over the regions.
+     *! \details Empty arrays, e.g. buffers which are not allocated for the
+     *!          current step, result in zero totals.
+    */
+    template<class Buffer, class Comm>
+    void sum(const std::vector<const Buffer*>& quantities, const Comm& comm)
+    {
+        const std::size_t numQuantities = quantities.size();
+#ifdef _OPENMP
+        beginSum(numQuantities, omp_get_max_threads());
+#else
+        beginSum(numQuantities, 1);
+#endif
+
+        const int numEntries = cells_.size();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+#ifdef _OPENMP
+            const std::size_t threadId = omp_get_thread_num();
+#else
+            const std::size_t threadId = 0;
+#endif
+            double* threadSums = partialSums_.data() + threadId*numRegions_*numQuantities;
+
+            // each thread gets a contiguous range of the cell lists, which
+            // usually spans only a few regions
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int entryIdx = 0; entryIdx < numEntries; ++entryIdx) {
+                const std::size_t cellIdx = cells_[entryIdx];
+                double* sums = threadSums + cellRegion_[cellIdx]*numQuantities;
+                for (std::size_t quantityIdx = 0; quantityIdx < numQuantities; ++quantityIdx) {
+                    const auto& values = *quantities[quantityIdx];
+                    if (!values.empty())
+                        sums[quantityIdx] += values[cellIdx];
+                }
+            }
+        }
+
+        endSum(comm);
+    }
+
+    /*! \brief Prepares the partial sums of all threads for a sum of the given
+     *!        number of quantities over the regions.
+     *! \details This and partialSums() and endSum() are used when the values
+     *!          of the cells are computed on the fly, e.g. in a loop over the
+     *!          cell lists. The loop should split the cell lists statically
+     *!          among the threads, since endSum() adds the partial sums in
+     *!          thread order.
+    */
+    void beginSum(std::size_t numQuantities, std::size_t numThreads)
+    {
+        numQuantities_ = numQuantities;
+        partialSums_.assign(numThreads*numRegions_*numQuantities_, 0.0);
+    }
+
+    /*! \brief Returns the sums of the quantities of a thread for the region of
+     *!        a cell, nullptr if the cell is not summed.
+    */
+    double* partialSums(std::size_t threadId, std::size_t cellIdx)
+    {
+        const int region = cellRegion_[cellIdx];
+        if (region < 0)
+            return nullptr;
+
+        assert((threadId + 1)*numRegions_*numQuantities_ <= partialSums_.size());
+        return partialSums_.data() + (threadId*numRegions_ + region)*numQuantities_;
+    }
+
+    //! \brief Adds up the partial sums of all threads and processes.
+    template<class Comm>
+    void endSum(const Comm& comm)
+    {
+        const std::size_t size = numRegions_*numQuantities_;
+        totals_.assign(size, 0.0);
+        for (std::size_t offset = 0; offset < partialSums_.size(); offset += size) {
+            for (std::size_t i = 0; i < size; ++i)
+                totals_[i] += partialSums_[offset + i];
+        }
+        if (size > 0)
+            comm.sum(totals_.data(), size);
+    }
+
+    //! \brief Returns the total of a quantity in a region after the last sum.
+    double total(std::size_t quantityIdx, std::size_t region) const
+    { return totals_[region*numQuantities_ + quantityIdx]; }
+
+    //! \brief Returns the totals of a quantity in all regions after the last sum.
+    std::vector<double> totals(std::size_t quantityIdx) const
+    {
+        std::vector<double> result(numRegions_);
+        for (std::size_t region = 0; region < numRegions_; ++region)
+            result[region] = total(quantityIdx, region);
+        return result;
+    }
+
+    //! \brief Returns the bytes of the cell lists and the sums.
+    std::size_t memoryUsage() const
+    {
+        return cellRegion_.capacity()*sizeof(int)
+            + (regionStart_.capacity() + cells_.capacity())*sizeof(std::size_t)
+            + (partialSums_.capacity() + totals_.capacity())*sizeof(double);
+    }
+
+private:
+    std::vector<int> cellRegion_;
+    std::size_t numRegions_ = 0;
+
+    // the cells of region i are cells_[regionStart_[i]] ... cells_[regionStart_[i+1] - 1]
+    std::vector<std::size_t> regionStart_;
+    std::vector<std::size_t> cells_;
+
+    // the sums are stored region by region, the quantities of a region are contiguous
+    std::size_t numQuantities_ = 0;
+    std::vector<double> partialSums_;
+    std::vector<double> totals_;
+};
+
+} // end namespace Opm
+
+#endif // OPM_REGION_AGGREGATOR_HPP
@@ -24,79 +24,96 @@
 
 #if HAVE_MPI
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <map>
 #include <numeric>
 #include <mpi.h>
 
 namespace
 {
 
-    void packMessages(const std::vector<Opm::DeferredLogger::Message>& local_messages, std::vector<char>& buf, int& offset)
+    // Computes the size of packed data.
+    struct PackSize
     {
-
-        int messagesize = local_messages.size();
-        MPI_Pack(&messagesize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
-
-        for (const auto lm : local_messages) {
-            MPI_Pack(static_cast<void*>(const_cast<std::int64_t*>(&lm.flag)), 1, MPI_INT64_T, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
-            int tagsize = lm.tag.size();
-            MPI_Pack(&tagsize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
-            if (tagsize>0) {
-                MPI_Pack(const_cast<char*>(lm.tag.c_str()), lm.tag.size(), MPI_CHAR, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
-            }
-            int textsize = lm.text.size();
-            MPI_Pack(&textsize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
-            if (textsize>0) {
-                MPI_Pack(const_cast<char*>(lm.text.c_str()), lm.text.size(), MPI_CHAR, buf.data(), buf.size(), &offset, MPI_COMM_WORLD);
+        void add(int) { size += packSize(1, MPI_INT); }
+        void add(unsigned) { size += packSize(1, MPI_UNSIGNED); }
+        void add(std::int64_t) { size += packSize(1, MPI_INT64_T); }
+        void add(double) { size += packSize(1, MPI_DOUBLE); }
+        void add(const char*, unsigned length)
+        {
+            add(length);
+            if (length > 0) {
+                size += packSize(length, MPI_CHAR);
             }
         }
-    }
+        void add(const std::string& value) { add(value.data(), value.size()); }
 
-    Opm::DeferredLogger::Message unpackSingleMessage(const std::vector<char>& recv_buffer, int& offset)
+        static int packSize(int count, MPI_Datatype type)
+        {
+            int result;
+            MPI_Pack_size(count, type, MPI_COMM_WORLD, &result);
+            return result;
+        }
+
+        int size = 0;
+    };
+
+    // Packs data into a buffer which is large enough.
+    struct Pack
     {
-        int64_t flag;
-        auto* data = const_cast<char*>(recv_buffer.data());
-        MPI_Unpack(data, recv_buffer.size(), &offset, &flag, 1, MPI_INT64_T, MPI_COMM_WORLD);
-
-        // unpack tag
-        unsigned int tagsize;
-        MPI_Unpack(data, recv_buffer.size(), &offset, &tagsize, 1, MPI_UNSIGNED, MPI_COMM_WORLD);
-        std::string tag;
-        if (tagsize>0) {
-            std::vector<char> tagchars(tagsize);
-            MPI_Unpack(data, recv_buffer.size(), &offset, tagchars.data(), tagsize, MPI_CHAR, MPI_COMM_WORLD);
-            tag = std::string(tagchars.data(), tagsize);
+        void add(int value) { pack(&value, 1, MPI_INT); }
+        void add(unsigned value) { pack(&value, 1, MPI_UNSIGNED); }
+        void add(std::int64_t value) { pack(&value, 1, MPI_INT64_T); }
+        void add(double value) { pack(&value, 1, MPI_DOUBLE); }
+        void add(const char* value, unsigned length)
+        {
+            add(length);
+            if (length > 0) {
+                pack(const_cast<char*>(value), length, MPI_CHAR);
+            }
         }
-        // unpack text
-        unsigned int textsize;
-        MPI_Unpack(data, recv_buffer.size(), &offset, &textsize, 1, MPI_UNSIGNED, MPI_COMM_WORLD);
-        std::string text;
-        if (textsize>0) {
-            std::vector<char> textchars(textsize);
-            MPI_Unpack(data, recv_buffer.size(), &offset, textchars.data(), textsize, MPI_CHAR, MPI_COMM_WORLD);
-            text = std::string (textchars.data(), textsize);
+        void add(const std::string& value) { add(value.data(), value.size()); }
+
+        void pack(void* data, int count, MPI_Datatype type)
+        {
+            MPI_Pack(data, count, type, buffer.data(), buffer.size(), &offset, MPI_COMM_WORLD);
         }
-        return Opm::DeferredLogger::Message({flag, tag, text});
-    }
 
-    std::vector<Opm::DeferredLogger::Message> unpackMessages(const std::vector<char>& recv_buffer, const std::vector<int>& displ)
+        std::vector<char>& buffer;
+        int offset = 0;
+    };
+
+    // Unpacks data from the part of a buffer which was sent by a process.
+    struct Unpack
     {
-        std::vector<Opm::DeferredLogger::Message> messages;
-        const int num_processes = displ.size() - 1;
-        auto* data = const_cast<char*>(recv_buffer.data());
-        for (int process = 0; process < num_processes; ++process) {
-            int offset = displ[process];
-            // unpack number of messages
-            unsigned int messagesize;
-            MPI_Unpack(data, recv_buffer.size(), &offset, &messagesize, 1, MPI_UNSIGNED, MPI_COMM_WORLD);
-            for (unsigned int i=0; i<messagesize; i++) {
-                messages.push_back(unpackSingleMessage(recv_buffer, offset));
+        template <class T>
+        T get(MPI_Datatype type)
+        {
+            T value;
+            MPI_Unpack(data(), buffer.size(), &offset, &value, 1, type, MPI_COMM_WORLD);
+            return value;
+        }
+        int getInt() { return get<int>(MPI_INT); }
+        unsigned getUnsigned() { return get<unsigned>(MPI_UNSIGNED); }
+        std::int64_t getInt64() { return get<std::int64_t>(MPI_INT64_T); }
+        double getDouble() { return get<double>(MPI_DOUBLE); }
+        std::string getString()
+        {
+            const unsigned length = getUnsigned();
+            std::string value(length, '\0');
+            if (length > 0) {
+                MPI_Unpack(data(), buffer.size(), &offset, &value[0], length, MPI_CHAR, MPI_COMM_WORLD);
             }
-            assert(offset == displ[process + 1]);
+            return value;
         }
-        return messages;
-    }
+
+        char* data() { return const_cast<char*>(buffer.data()); }
+
+        const std::vector<char>& buffer;
+        int offset;
+    };
 
 } // anonymous namespace
 
@@ -105,37 +122,70 @@ namespace Opm
 {
 
     /// combine (per-process) messages
+    ///
+    /// Messages of interned templates are sent as the id of the template and
+    /// their packed arguments. The templates used by a process are sent once.
     Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger)
     {
+        using Argument = DeferredLogger::Argument;
+        const auto& local = local_deferredlogger;
 
-        int num_messages = local_deferredlogger.messages_.size();
-
-        int int64_mpi_pack_size;
-        MPI_Pack_size(1, MPI_INT64_T, MPI_COMM_WORLD, &int64_mpi_pack_size);
-        int unsigned_int_mpi_pack_size;
-        MPI_Pack_size(1, MPI_UNSIGNED, MPI_COMM_WORLD, &unsigned_int_mpi_pack_size);
-
-        // store number of messages;
-        int message_size = unsigned_int_mpi_pack_size;
-        // store 1 int64 per message for flag
-        message_size += num_messages*int64_mpi_pack_size;
-        // store 2 unsigned ints per message for length of tag and length of text
-        message_size += num_messages*2*unsigned_int_mpi_pack_size;
-
-        for (const auto lm : local_deferredlogger.messages_) {
-            int string_mpi_pack_size;
-            MPI_Pack_size(lm.tag.size(), MPI_CHAR, MPI_COMM_WORLD, &string_mpi_pack_size);
-            message_size += string_mpi_pack_size;
-            MPI_Pack_size(lm.text.size(), MPI_CHAR, MPI_COMM_WORLD, &string_mpi_pack_size);
-            message_size += string_mpi_pack_size;
+        std::vector<int> templateIds;
+        for (const auto& lm : local.messages_) {
+            if (lm.templateId >= 0) {
+                templateIds.push_back(lm.templateId);
+            }
         }
+        std::sort(templateIds.begin(), templateIds.end());
+        templateIds.erase(std::unique(templateIds.begin(), templateIds.end()), templateIds.end());
+
+        // the layout of the local messages, used to compute their size and to pack them
+        const auto packMessages = [&local, &templateIds](auto& packer) {
+            packer.add(static_cast<unsigned>(templateIds.size()));
+            for (const int templateId : templateIds) {
+                const auto& messageTemplate = DeferredLogger::messageTemplate_(templateId);
+                packer.add(templateId);
+                packer.add(messageTemplate.first);
+                packer.add(messageTemplate.second);
+            }
+
+            packer.add(static_cast<unsigned>(local.messages_.size()));
+            for (const auto& lm : local.messages_) {
+                packer.add(static_cast<std::int64_t>(lm.flag));
+                packer.add(lm.templateId);
+                if (lm.templateId < 0) {
+                    packer.add(lm.tag);
+                    packer.add(lm.text);
+                    continue;
+                }
+                packer.add(lm.numArguments);
+                for (unsigned i = 0; i < lm.numArguments; ++i) {
+                    const auto& arg = local.arguments_[lm.firstArgument + i];
+                    packer.add(static_cast<int>(arg.type));
+                    switch (arg.type) {
+                    case Argument::Integer:
+                        packer.add(arg.integer);
+                        break;
+                    case Argument::Float:
+                        packer.add(arg.floating);
+                        break;
+                    case Argument::String:
+                        packer.add(local.chars_.data() + arg.integer, arg.size);
+                        break;
+                    }
+                }
+            }
+        };
+
+        PackSize packSize;
+        packMessages(packSize);
+        const int message_size = packSize.size;
 
         // Pack local messages.
         std::vector<char> buffer(message_size);
-
-        int offset = 0;
-        packMessages(local_deferredlogger.messages_, buffer, offset);
-        assert(offset == message_size);
+        Pack pack{buffer};
+        packMessages(pack);
+        assert(pack.offset <= message_size);
 
         // Get message sizes and create offset/displacement array for gathering.
         int num_processes = -1;
@@ -152,9 +202,54 @@ namespace Opm
                        displ.data(), MPI_PACKED,
                        MPI_COMM_WORLD);
 
-        // Unpack.
+        // Unpack. The template ids of the other processes are mapped to the ones
+        // of this process.
         Opm::DeferredLogger global_deferredlogger;
-        global_deferredlogger.messages_ = unpackMessages(recv_buffer, displ);
+        auto& global = global_deferredlogger;
+        for (int process = 0; process < num_processes; ++process) {
+            Unpack unpack{recv_buffer, displ[process]};
+
+            std::map<int, int> localTemplateIds;
+            const unsigned num_templates = unpack.getUnsigned();
+            for (unsigned i = 0; i < num_templates; ++i) {
+                const int templateId = unpack.getInt();
+                const std::string tag = unpack.getString();
+                const std::string text = unpack.getString();
+                localTemplateIds[templateId] = DeferredLogger::messageTemplate(tag, text);
+            }
+
+            const unsigned num_messages = unpack.getUnsigned();
+            for (unsigned i = 0; i < num_messages; ++i) {
+                const std::int64_t flag = unpack.getInt64();
+                const int templateId = unpack.getInt();
+                if (templateId < 0) {
+                    std::string tag = unpack.getString();
+                    std::string text = unpack.getString();
+                    global.messages_.push_back({flag, std::move(tag), std::move(text)});
+                    continue;
+                }
+
+                const unsigned num_arguments = unpack.getUnsigned();
+                global.messages_.push_back({flag, std::string(), std::string(),
+                                            localTemplateIds.at(templateId),
+                                            static_cast<unsigned>(global.arguments_.size()),
+                                            num_arguments});
+                for (unsigned j = 0; j < num_arguments; ++j) {
+                    switch (unpack.getInt()) {
+                    case Argument::Integer:
+                        global.addArgument_(unpack.getInt64());
+                        break;
+                    case Argument::Float:
+                        global.addArgument_(unpack.getDouble());
+                        break;
+                    default:
+                        global.addArgument_(unpack.getString());
+                        break;
+                    }
+                }
+            }
+            assert(unpack.offset <= displ[process + 1]);
+        }
         return global_deferredlogger;
     }
 
@@ -31,6 +31,7 @@
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
 #include <cassert>
+#include <map>
 #include <tuple>
 
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
@@ -81,6 +82,7 @@ namespace Opm {
             typedef typename GET_PROP_TYPE(TypeTag, Grid)                Grid;
             typedef typename GET_PROP_TYPE(TypeTag, FluidSystem)         FluidSystem;
             typedef typename GET_PROP_TYPE(TypeTag, ElementContext)      ElementContext;
+            typedef typename GET_PROP_TYPE(TypeTag, ThreadManager)       ThreadManager;
             typedef typename GET_PROP_TYPE(TypeTag, Indices)             Indices;
             typedef typename GET_PROP_TYPE(TypeTag, Simulator)           Simulator;
             typedef typename GET_PROP_TYPE(TypeTag, Scalar)              Scalar;
@@ -124,6 +126,10 @@ namespace Opm {
 
             void linearize(SparseMatrixAdapter& jacobian, GlobalEqVector& res);
 
+            // Only applies the vector part of the Schur complement, for
+            // iterations which reuse an earlier Jacobian.
+            void linearizeResidual(GlobalEqVector& res);
+
             void postSolve(GlobalEqVector& deltaX)
             {
                 recoverWellSolutionAndUpdateWellState(deltaX);
@@ -255,6 +261,10 @@ namespace Opm {
 
             const SimulatorReportSingle& lastReport() const;
 
+            // number of bytes held by the linear systems of the wells and the
+            // per-cell and per-perforation data of the model
+            std::size_t memoryUsage() const;
+
             void addWellContributions(SparseMatrixAdapter& jacobian) const
             {
                 for ( const auto& well: well_container_ ) {
@@ -272,10 +282,35 @@ namespace Opm {
             /// Returns true if the well was actually found and shut.
             bool forceShutWellByNameIfPredictionMode(const std::string& wellname, const double simulation_time);
 
+            /// Put a producer (injector) under the given control with the given
+            /// target in SI units for the rest of the simulation, overriding the
+            /// controls of the schedule. Takes effect at the next report step.
+            /// Throws std::invalid_argument if the well is not in the schedule,
+            /// or if it is an injector (producer) at the next report step.
+            void setWellTarget(const std::string& wellname, const Well::ProducerCMode cmode, const double target);
+            void setWellTarget(const std::string& wellname, const Well::InjectorCMode cmode, const double target);
+
         protected:
             Simulator& ebosSimulator_;
 
             std::vector< Well > wells_ecl_;
+
+            // controls set by setWellTarget(), by well name
+            struct WellTargetOverride
+            {
+                bool is_producer;
+                Well::ProducerCMode producer_cmode;
+                Well::InjectorCMode injector_cmode;
+                double target;
+                int first_report_step;
+            };
+            std::map<std::string, WellTargetOverride> well_target_overrides_;
+
+            // throw unless wellname is a producer (injector) of the schedule
+            void checkWellTargetWell_(const std::string& wellname, const bool is_producer) const;
+
+            // apply well_target_overrides_ to wells_ecl_
+            void applyWellTargetOverrides_(const int report_step);
             std::vector< std::vector<PerforationData> > well_perf_data_;
             std::vector<int> first_perf_index_;
 
@@ -22,8 +22,13 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/wells/SimFIBODetails.hpp>
+#include <opm/parser/eclipse/Deck/UDAValue.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
+#include <dune/common/timer.hh>
+
+#include <memory>
+
 namespace Opm {
     template<typename TypeTag>
     BlackoilWellModel<TypeTag>::
@@ -145,6 +150,21 @@ namespace Opm {
     }
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    linearizeResidual(GlobalEqVector& res)
+    {
+        if (!localWellsActive())
+            return;
+
+        for (const auto& well: well_container_) {
+            // r = r - duneC_^T * invDuneD_ * resWell_
+            well->apply(res);
+        }
+    }
+
+
     /// Return true if any well has a THP constraint.
     template<typename TypeTag>
     bool
@@ -200,6 +220,173 @@ namespace Opm {
 
 
 
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setWellTarget(const std::string& wellname, const Well::ProducerCMode cmode, const double target)
+    {
+        switch (cmode) {
+        case Well::ProducerCMode::ORAT:
+        case Well::ProducerCMode::WRAT:
+        case Well::ProducerCMode::GRAT:
+        case Well::ProducerCMode::LRAT:
+        case Well::ProducerCMode::RESV:
+        case Well::ProducerCMode::BHP:
+        case Well::ProducerCMode::THP:
+            break;
+        default:
+            OPM_THROW(std::invalid_argument, "Unsupported control mode for the target of producer " << wellname);
+        }
+        checkWellTargetWell_(wellname, /*is_producer=*/true);
+
+        WellTargetOverride target_override;
+        target_override.is_producer = true;
+        target_override.producer_cmode = cmode;
+        target_override.injector_cmode = Well::InjectorCMode::CMODE_UNDEFINED;
+        target_override.target = target;
+        target_override.first_report_step = -1;
+        well_target_overrides_[wellname] = target_override;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setWellTarget(const std::string& wellname, const Well::InjectorCMode cmode, const double target)
+    {
+        switch (cmode) {
+        case Well::InjectorCMode::RATE:
+        case Well::InjectorCMode::RESV:
+        case Well::InjectorCMode::BHP:
+        case Well::InjectorCMode::THP:
+            break;
+        default:
+            OPM_THROW(std::invalid_argument, "Unsupported control mode for the target of injector " << wellname);
+        }
+        checkWellTargetWell_(wellname, /*is_producer=*/false);
+
+        WellTargetOverride target_override;
+        target_override.is_producer = false;
+        target_override.producer_cmode = Well::ProducerCMode::CMODE_UNDEFINED;
+        target_override.injector_cmode = cmode;
+        target_override.target = target;
+        target_override.first_report_step = -1;
+        well_target_overrides_[wellname] = target_override;
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    checkWellTargetWell_(const std::string& wellname, const bool is_producer) const
+    {
+        const auto& sched = schedule();
+        if (!sched.hasWell(wellname)) {
+            OPM_THROW(std::invalid_argument, "Cannot set the target of " << wellname << ", there is no such well in the schedule");
+        }
+
+        // the target takes effect at the next report step. a well which is
+        // introduced later is checked at the first report step defining it.
+        const std::size_t next_step = std::min(std::size_t(std::max(ebosSimulator_.episodeIndex() + 1, 0)),
+                                               sched.size() - 1);
+        std::size_t step = next_step;
+        while (step < sched.size() && !sched.hasWell(wellname, step)) {
+            ++step;
+        }
+        if (step == sched.size()) {
+            OPM_THROW(std::invalid_argument, "Cannot set the target of " << wellname << ", the well is not part of the remaining schedule");
+        }
+
+        const bool well_is_producer = sched.getWell(wellname, step).isProducer();
+        if (well_is_producer != is_producer) {
+            OPM_THROW(std::invalid_argument, "Cannot set " << (is_producer ? "a producer" : "an injector")
+                      << " target for " << wellname << ", which is " << (well_is_producer ? "a producer" : "an injector"));
+        }
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    applyWellTargetOverrides_(const int report_step)
+    {
+        for (auto& well : wells_ecl_) {
+            auto target_override = well_target_overrides_.find(well.name());
+            if (target_override == well_target_overrides_.end()) {
+                continue;
+            }
+
+            auto& over = target_override->second;
+            if (over.first_report_step < 0) {
+                over.first_report_step = report_step;
+            }
+
+            const UDAValue target(over.target);
+            if (over.is_producer && well.isProducer()) {
+                auto properties = std::make_shared<Well::WellProductionProperties>(well.getProductionProperties());
+                switch (over.producer_cmode) {
+                case Well::ProducerCMode::ORAT:
+                    properties->OilRate = target;
+                    break;
+                case Well::ProducerCMode::WRAT:
+                    properties->WaterRate = target;
+                    break;
+                case Well::ProducerCMode::GRAT:
+                    properties->GasRate = target;
+                    break;
+                case Well::ProducerCMode::LRAT:
+                    properties->LiquidRate = target;
+                    break;
+                case Well::ProducerCMode::RESV:
+                    properties->ResVRate = target;
+                    break;
+                case Well::ProducerCMode::BHP:
+                    properties->BHPTarget = target;
+                    break;
+                default:
+                    properties->THPTarget = target;
+                }
+                properties->predictionMode = true;
+                properties->controlMode = over.producer_cmode;
+                properties->addProductionControl(over.producer_cmode);
+                well.updateProduction(properties);
+            }
+            else if (!over.is_producer && well.isInjector()) {
+                auto properties = std::make_shared<Well::WellInjectionProperties>(well.getInjectionProperties());
+                switch (over.injector_cmode) {
+                case Well::InjectorCMode::RATE:
+                    properties->surfaceInjectionRate = target;
+                    break;
+                case Well::InjectorCMode::RESV:
+                    properties->reservoirInjectionRate = target;
+                    break;
+                case Well::InjectorCMode::BHP:
+                    properties->BHPTarget = target;
+                    break;
+                default:
+                    properties->THPTarget = target;
+                }
+                properties->predictionMode = true;
+                properties->controlMode = over.injector_cmode;
+                properties->addInjectionControl(over.injector_cmode);
+                well.updateInjection(properties);
+            }
+        }
+    }
+
+
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -222,6 +409,7 @@ namespace Opm {
             w.erase(std::remove_if(w.begin(), w.end(), is_shut_or_defunct), w.end());
             wells_ecl_.swap(w);
         }
+        applyWellTargetOverrides_(timeStepIdx);
         initializeWellPerfData();
 
         // Wells are active if they are active wells on at least
@@ -279,7 +467,12 @@ namespace Opm {
                                                  + ScheduleEvents::INJECTION_UPDATE
                                                  + ScheduleEvents::NEW_WELL;
 
-            if(!schedule().hasWellGroupEvent(well.name(), effective_events_mask, timeStepIdx))
+            // a target set by setWellTarget() counts as a new control
+            const auto target_override = well_target_overrides_.find(well.name());
+            const bool new_target = target_override != well_target_overrides_.end()
+                && target_override->second.first_report_step == timeStepIdx;
+
+            if(!new_target && !schedule().hasWellGroupEvent(well.name(), effective_events_mask, timeStepIdx))
                 continue;
 
             if (well.isProducer()) {
@@ -294,10 +487,12 @@ namespace Opm {
         const Group& fieldGroup = schedule().getGroup("FIELD", timeStepIdx);
         WellGroupHelpers::setCmodeGroup(fieldGroup, schedule(), summaryState, timeStepIdx, well_state_);
 
-        // Compute reservoir volumes for RESV controls.
-        rateConverter_.reset(new RateConverterType (phase_usage_,
-                                                    std::vector<int>(number_of_cells_, 0)));
-        rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+        // Compute reservoir volumes for RESV controls. all cells are in the same
+        // region, so the converter is kept for the whole run.
+        if (!rateConverter_)
+            rateConverter_.reset(new RateConverterType (phase_usage_,
+                                                        std::vector<int>(number_of_cells_, 0)));
+        rateConverter_->template defineState<ElementContext, ThreadManager>(ebosSimulator_);
 
         // update VFP properties
         vfp_properties_.reset (new VFPProperties<VFPInjProperties,VFPProdProperties> (
@@ -453,7 +648,7 @@ namespace Opm {
         updateWellTestState(simulationTime, wellTestState_);
 
         // update the rate converter with current averages pressures etc in
-        rateConverter_->template defineState<ElementContext>(ebosSimulator_);
+        rateConverter_->template defineState<ElementContext, ThreadManager>(ebosSimulator_);
 
         // calculate the well potentials
         try {
@@ -1301,20 +1496,21 @@ namespace Opm {
         std::vector< Scalar > B_avg(numComponents(), Scalar() );
         computeAverageFormationFactor(B_avg);
 
-        const Opm::SummaryConfig& summaryConfig = ebosSimulator_.vanguard().summaryConfig();
         const bool write_restart_file = ebosSimulator_.vanguard().schedule().restart().getWriteRestartFile(reportStepIdx);
+
+        Dune::Timer potentialTimer;
+        potentialTimer.start();
+
+        // the wells are processed one after the other: the mobilities of
+        // connections with their own saturation table temporarily change the
+        // material law parameters of the connection cell, which are shared.
         int exception_thrown = 0;
         try {
             for (const auto& well : well_container_) {
-                const bool needed_for_summary = ((summaryConfig.hasSummaryKey( "WWPI:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WOPI:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WGPI:" + well->name())) && well->isInjector()) ||
-                                                ((summaryConfig.hasSummaryKey( "WWPP:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WOPP:" + well->name()) ||
-                                                  summaryConfig.hasSummaryKey( "WGPP:" + well->name())) && well->isProducer());
-
+                // the guide rates currently always need the potentials, so the
+                // summary keys WxPI/WxPP do not have to be checked.
                 bool needPotentialsForGuideRate = true;//eclWell.getGuideRatePhase() == Well::GuideRateTarget::UNDEFINED;
-                if (write_restart_file || needed_for_summary || needPotentialsForGuideRate)
+                if (write_restart_file || needPotentialsForGuideRate)
                 {
                     std::vector<double> potentials;
                     well->computeWellPotentials(ebosSimulator_, B_avg, well_state_copy, potentials, deferred_logger);
@@ -1328,6 +1524,9 @@ namespace Opm {
             exception_thrown = 1;
         }
 
+        deferred_logger.debug("Computed the potentials of " + std::to_string(well_container_.size()) + " wells in "
+                              + std::to_string(potentialTimer.stop()) + " seconds");
+
         logAndCheckForExceptionsAndThrow(deferred_logger, exception_thrown, "computeWellPotentials() failed.", terminal_output_);
 
         // Store it in the well state
@@ -1390,6 +1589,28 @@ namespace Opm {
     wellState(const WellState& well_state OPM_UNUSED) const { return wellState(); }
 
 
+
+    template<typename TypeTag>
+    std::size_t
+    BlackoilWellModel<TypeTag>::
+    memoryUsage() const
+    {
+        std::size_t bytes = memoryUsageOf(cartesian_to_compressed_)
+            + memoryUsageOf(is_cell_perforated_)
+            + memoryUsageOf(pvt_region_idx_)
+            + memoryUsageOf(depth_)
+            + memoryUsageOf(first_perf_index_)
+            + scaleAddRes_.size() * sizeof(typename BVector::block_type);
+        for (const auto& perf_data : well_perf_data_) {
+            bytes += memoryUsageOf(perf_data);
+        }
+        for (const auto& well : well_container_) {
+            bytes += well->memoryUsage();
+        }
+        return bytes;
+    }
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
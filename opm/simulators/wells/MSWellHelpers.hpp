@@ -26,11 +26,16 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/SpiralICD.hpp>
+#include <dune/common/fmatrix.hh>
 #include <dune/istl/solvers.hh>
 #if HAVE_UMFPACK
 #include <dune/istl/umfpack.hh>
 #endif // HAVE_UMFPACK
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 namespace Opm {
 
@@ -75,6 +80,166 @@ namespace mswellhelpers
 
 
 
+    // Direct solver for the segment system D of a multisegment well.
+    //
+    // The segments of a well form a tree with the top segment as root, and
+    // the off-diagonal blocks of D only couple a segment with its outlet and
+    // its inlet segments. Eliminating the segments from the leaves towards
+    // the top segment is then a block LU factorization without fill-in, and
+    // both the factorization and the solves cost O(number of segments).
+    template <typename MatrixType, typename VectorType>
+    class SegmentTreeSolver
+    {
+    public:
+        using BlockType = typename MatrixType::block_type;
+
+        // factorize D, segment_inlets gives the inlet segments of each segment.
+        // It returns false when D does not follow the segment tree or when a
+        // pivot block is singular, the solver can not be used in that case.
+        bool factorize(const MatrixType& D, const std::vector<std::vector<int>>& segment_inlets)
+        {
+            factorized_ = false;
+            const int num_seg = D.N();
+            if (num_seg == 0 || static_cast<int>(segment_inlets.size()) != num_seg) {
+                return false;
+            }
+
+            // depth-first traversal from the top segment, in the reversed
+            // traversal order every segment comes after all its inlets.
+            outlet_.assign(num_seg, -1);
+            order_.clear();
+            order_.reserve(num_seg);
+            std::vector<int> stack(1, 0);
+            while (!stack.empty()) {
+                const int seg = stack.back();
+                stack.pop_back();
+                order_.push_back(seg);
+                for (const int inlet : segment_inlets[seg]) {
+                    if (inlet <= 0 || inlet >= num_seg || outlet_[inlet] != -1) {
+                        return false;
+                    }
+                    outlet_[inlet] = seg;
+                    stack.push_back(inlet);
+                }
+            }
+            if (static_cast<int>(order_.size()) != num_seg) {
+                return false;
+            }
+            std::reverse(order_.begin(), order_.end());
+
+            pivot_.assign(num_seg, BlockType(0.0));
+            upper_.assign(num_seg, BlockType(0.0));
+            lower_.assign(num_seg, BlockType(0.0));
+            for (auto row = D.begin(); row != D.end(); ++row) {
+                const int seg = row.index();
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    const int col_seg = col.index();
+                    if (col_seg == seg) {
+                        pivot_[seg] = *col;
+                    } else if (col_seg == outlet_[seg]) {
+                        upper_[seg] = *col;
+                    } else if (outlet_[col_seg] == seg) {
+                        lower_[col_seg] = *col;
+                    } else {
+                        return false;
+                    }
+                }
+            }
+
+            // after the elimination pivot_ holds the inverse of the pivot blocks
+            // and upper_ holds inv(pivot) * D[seg][outlet].
+            try {
+                for (const int seg : order_) {
+                    if (singularPivot(pivot_[seg])) {
+                        return false;
+                    }
+                    pivot_[seg].invert();
+                    const int outlet = outlet_[seg];
+                    if (outlet >= 0) {
+                        upper_[seg].leftmultiply(pivot_[seg]);
+                        BlockType update = lower_[seg];
+                        update.rightmultiply(upper_[seg]);
+                        pivot_[outlet] -= update;
+                    }
+                }
+            } catch (const Dune::FMatrixError&) {
+                return false;
+            }
+
+            factorized_ = true;
+            return true;
+        }
+
+        bool factorized() const
+        {
+            return factorized_;
+        }
+
+        // obtain y = D^-1 * x with the factorization
+        VectorType solve(VectorType x) const
+        {
+            assert(factorized_);
+            VectorType y(x.size());
+            // forward substitution, from the leaves towards the top segment
+            for (const int seg : order_) {
+                pivot_[seg].mv(x[seg], y[seg]);
+                const int outlet = outlet_[seg];
+                if (outlet >= 0) {
+                    lower_[seg].mmv(y[seg], x[outlet]);
+                }
+            }
+            // backward substitution, from the top segment towards the leaves
+            for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+                const int outlet = outlet_[*it];
+                if (outlet >= 0) {
+                    upper_[*it].mmv(y[outlet], y[*it]);
+                }
+            }
+
+            for (size_t i_block = 0; i_block < y.size(); ++i_block) {
+                for (size_t i_elem = 0; i_elem < y[i_block].size(); ++i_elem) {
+                    if (std::isinf(y[i_block][i_elem]) || std::isnan(y[i_block][i_elem]) ) {
+                        OPM_THROW(Opm::NumericalIssue, "nan or inf value found in SegmentTreeSolver due to singular matrix");
+                    }
+                }
+            }
+
+            return y;
+        }
+
+    private:
+        // FieldMatrix::invert() only detects singular matrices when
+        // DUNE_FMatrix_WITH_CHECKING is defined, otherwise it returns inf
+        // or nan entries. The determinant is compared against the product
+        // of the row norms, which bounds it from above.
+        static bool singularPivot(const BlockType& pivot)
+        {
+            using Scalar = typename BlockType::field_type;
+            Scalar row_norm_product = 1.0;
+            for (int i = 0; i < BlockType::rows; ++i) {
+                row_norm_product *= pivot[i].two_norm();
+            }
+            const Scalar det = pivot.determinant();
+            if (!std::isfinite(det) || !std::isfinite(row_norm_product)) {
+                return true;
+            }
+            return std::abs(det) <= 100 * std::numeric_limits<Scalar>::epsilon() * row_norm_product;
+        }
+
+        bool factorized_ = false;
+        // segments in elimination order, every segment after its inlets
+        std::vector<int> order_;
+        // the outlet of each segment, -1 for the top segment
+        std::vector<int> outlet_;
+        std::vector<BlockType> pivot_;
+        std::vector<BlockType> upper_;
+        std::vector<BlockType> lower_;
+    };
+
+
+
+
+
     // obtain y = D^-1 * x with a BICSSTAB iterative solver
     template <typename MatrixType, typename VectorType>
     VectorType
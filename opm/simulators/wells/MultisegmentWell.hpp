@@ -24,6 +24,7 @@
 
 
 #include <opm/simulators/wells/WellInterface.hpp>
+#include <opm/simulators/wells/MSWellHelpers.hpp>
 
 namespace Opm
 {
@@ -158,6 +159,8 @@ namespace Opm
 
         virtual void  addWellContributions(SparseMatrixAdapter& jacobian) const override;
 
+        virtual std::size_t memoryUsage() const override;
+
         /// number of segments for this well
         /// int number_of_segments_;
         int numberOfSegments() const;
@@ -231,6 +234,8 @@ namespace Opm
         mutable OffDiagMatWell duneC_;
         // diagonal matrix for the well
         mutable DiagMatWell duneD_;
+        // factorization of duneD_ following the segment tree, updated after each assembly
+        mutable mswellhelpers::SegmentTreeSolver<DiagMatWell, BVectorWell> duneD_solver_;
 
         // residuals of the well equations
         mutable BVectorWell resWell_;
@@ -290,6 +295,9 @@ namespace Opm
         // xw = inv(D)*(rw - C*x)
         void recoverSolutionWell(const BVector& x, BVectorWell& xw) const;
 
+        // obtain y = D^-1 * x, using the segment tree factorization when it is available
+        BVectorWell invDX(const BVectorWell& x) const;
+
         // updating the well_state based on well solution dwells
         void updateWellState(const BVectorWell& dwells,
                              WellState& well_state,
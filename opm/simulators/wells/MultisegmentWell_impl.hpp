@@ -616,7 +616,7 @@ namespace Opm
         duneB_.mv(x, Bx);
 
         // invDBx = duneD^-1 * Bx_
-        const BVectorWell invDBx = mswellhelpers::invDXDirect(duneD_, Bx);
+        const BVectorWell invDBx = invDX(Bx);
 
         // Ax = Ax - duneC_^T * invDBx
         duneC_.mmtv(invDBx,Ax);
@@ -632,7 +632,7 @@ namespace Opm
     apply(BVector& r) const
     {
         // invDrw_ = duneD^-1 * resWell_
-        const BVectorWell invDrw = mswellhelpers::invDXDirect(duneD_, resWell_);
+        const BVectorWell invDrw = invDX(resWell_);
         // r = r - duneC_^T * invDrw
         duneC_.mmtv(invDrw, r);
     }
@@ -930,7 +930,23 @@ namespace Opm
         // resWell = resWell - B * x
         duneB_.mmv(x, resWell);
         // xw = D^-1 * resWell
-        xw = mswellhelpers::invDXDirect(duneD_, resWell);
+        xw = invDX(resWell);
+    }
+
+
+
+
+
+    template <typename TypeTag>
+    typename MultisegmentWell<TypeTag>::BVectorWell
+    MultisegmentWell<TypeTag>::
+    invDX(const BVectorWell& x) const
+    {
+        if (duneD_solver_.factorized()) {
+            return duneD_solver_.solve(x);
+        }
+        // the pivot blocks of the segment tree were singular, use the general sparse LU
+        return mswellhelpers::invDXDirect(duneD_, x);
     }
 
 
@@ -944,7 +960,7 @@ namespace Opm
     {
         // We assemble the well equations, then we check the convergence,
         // which is why we do not put the assembleWellEq here.
-        const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+        const BVectorWell dx_well = invDX(resWell_);
 
         updateWellState(dx_well, well_state, deferred_logger);
     }
@@ -1117,6 +1133,20 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    std::size_t
+    MultisegmentWell<TypeTag>::
+    memoryUsage() const
+    {
+        // the factorization of the segment tree has the blocks of duneD_
+        return matrixMemoryUsage(duneB_) + matrixMemoryUsage(duneC_) + 2*matrixMemoryUsage(duneD_)
+            + resWell_.size() * sizeof(typename BVectorWell::block_type);
+    }
+
+
+
+
+
     template <typename TypeTag>
     const WellSegments&
     MultisegmentWell<TypeTag>::
@@ -2316,7 +2346,7 @@ namespace Opm
 
             assembleWellEqWithoutIteration(ebosSimulator, dt, inj_controls, prod_controls, well_state, deferred_logger);
 
-            const BVectorWell dx_well = mswellhelpers::invDXDirect(duneD_, resWell_);
+            const BVectorWell dx_well = invDX(resWell_);
 
 
             const auto report = getWellConvergence(well_state, B_avg, deferred_logger);
@@ -2556,6 +2586,9 @@ namespace Opm
                                              well_state.segPressDropFriction()[seg] +
                                              well_state.segPressDropAcceleration()[seg];
         }
+
+        // the same D is used for all solves until the next assembly
+        duneD_solver_.factorize(duneD_, segment_inlets_);
     }
 
 
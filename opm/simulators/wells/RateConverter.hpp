@@ -25,10 +25,13 @@
 #include <opm/core/props/BlackoilPhases.hpp>
 #include <opm/grid/utility/RegionMapping.hpp>
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
+#include <opm/simulators/utils/RegionAggregator.hpp>
 
 #include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/rangegenerators.hh>
 #include <algorithm>
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
@@ -429,97 +432,111 @@ namespace Opm {
              * reservoir voidage rate.
              *
              */
-            template <typename ElementContext, class EbosSimulator>
+            template <typename ElementContext, class ThreadManager, class EbosSimulator>
             void defineState(const EbosSimulator& simulator)
             {
-
-                // create map from cell to region
-                // and set all attributes to zero
-                const auto& grid = simulator.vanguard().grid();
-                const unsigned numCells = grid.size(/*codim=*/0);
-                std::vector<int> cell2region(numCells, -1);
-                for (const auto& reg : rmap_.activeRegions()) {
-                    for (const auto& cell : rmap_.cells(reg)) {
-                        cell2region[cell] = reg;
-                    }
-                    auto& ra = attr_.attributes(reg);
-                    ra.pressure = 0.0;
-                    ra.temperature = 0.0;
-                    ra.rs = 0.0;
-                    ra.rv = 0.0;
-                    ra.pv = 0.0;
-
-                }
-
-                ElementContext elemCtx( simulator );
+                using GridView = std::decay_t<decltype(simulator.gridView())>;
+                using ElementSeed = typename GridView::template Codim<0>::Entity::EntitySeed;
                 const auto& gridView = simulator.gridView();
                 const auto& comm = gridView.comm();
 
-                const auto& elemEndIt = gridView.template end</*codim=*/0>();
-                for (auto elemIt = gridView.template begin</*codim=*/0>();
-                     elemIt != elemEndIt;
-                     ++elemIt)
-                {
-
-                    const auto& elem = *elemIt;
-                    if (elem.partitionType() != Dune::InteriorEntity)
-                        continue;
-
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& fs = intQuants.fluidState();
-                    // use pore volume weighted averages.
-                    const double pv_cell =
-                            simulator.model().dofTotalVolume(cellIdx)
-                            * intQuants.porosity().value();
-
-                    // only count oil and gas filled parts of the domain
-                    double hydrocarbon = 1.0;
-                    const auto& pu = phaseUsage_;
-                    if (Details::PhaseUsed::water(pu)) {
-                        hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
+                // the regions of the cells do not change, so their cell lists and
+                // the seeds of the owned elements are created on the first call
+                // only. the region IDs are used as region indices to have the same
+                // regions on all processes.
+                if (!regionSums_) {
+                    std::vector<int> region(gridView.size(/*codim=*/0), -1);
+                    for (const auto& reg : rmap_.activeRegions()) {
+                        for (const auto& cell : rmap_.cells(reg)) {
+                            region[cell] = reg;
+                        }
                     }
-
-                    int reg = cell2region[cellIdx];
-                    assert(reg >= 0);
-                    auto& ra = attr_.attributes(reg);
-                    auto& p  = ra.pressure;
-                    auto& T  = ra.temperature;
-                    auto& rs  = ra.rs;
-                    auto& rv  = ra.rv;
-                    auto& pv  = ra.pv;
-
-                    // sum p, rs, rv, and T.
-                    double hydrocarbonPV = pv_cell*hydrocarbon;
-                    if (hydrocarbonPV > 0) {
-                        pv += hydrocarbonPV;
-                        p += fs.pressure(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
-                        rs += fs.Rs().value()*hydrocarbonPV;
-                        rv += fs.Rv().value()*hydrocarbonPV;
-                        T += fs.temperature(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
+                    auto elementSeeds = std::make_unique<ElementSeeds<ElementSeed>>();
+                    elementSeeds->seeds.resize(region.size());
+                    std::vector<int> cellRegion(region.size(), -1);
+                    for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                        const unsigned cellIdx = simulator.model().elementMapper().index(elem);
+                        cellRegion[cellIdx] = region[cellIdx];
+                        elementSeeds->seeds[cellIdx] = elem.seed();
+                    }
+                    regionSums_.reset(new RegionAggregator(cellRegion, comm));
+                    elementSeeds_ = std::move(elementSeeds);
+                }
+                const auto& seeds = static_cast<const ElementSeeds<ElementSeed>&>(*elementSeeds_).seeds;
+
+                // sum the hydrocarbon pore volume weighted p, T, rs and rv of the
+                // cells owned by this process. the cell lists are split statically
+                // among the threads and the partial sums of the threads are added
+                // in thread order, so the sums do not change between runs with the
+                // same number of threads.
+                regionSums_->beginSum(NumSums, ThreadManager::maxThreads());
+                const int numEntries = regionSums_->numEntries();
+                std::exception_ptr exception;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                {
+                    const std::size_t threadId = ThreadManager::threadId();
+                    ElementContext elemCtx( simulator );
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                    for (int entryIdx = 0; entryIdx < numEntries; ++entryIdx) {
+                        try {
+                            const std::size_t cellIdx = regionSums_->cell(entryIdx);
+                            // the element context keeps a reference to the element
+                            const auto elem = gridView.grid().entity(seeds[cellIdx]);
+                            elemCtx.updatePrimaryStencil(elem);
+                            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                            const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+                            const auto& fs = intQuants.fluidState();
+                            // use pore volume weighted averages.
+                            const double pv_cell =
+                                    simulator.model().dofTotalVolume(cellIdx)
+                                    * intQuants.porosity().value();
+
+                            // only count oil and gas filled parts of the domain
+                            double hydrocarbon = 1.0;
+                            const auto& pu = phaseUsage_;
+                            if (Details::PhaseUsed::water(pu)) {
+                                hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
+                            }
+
+                            double* sums = regionSums_->partialSums(threadId, cellIdx);
+                            assert(sums != nullptr);
+
+                            // sum p, rs, rv, and T.
+                            const double hydrocarbonPV = pv_cell*hydrocarbon;
+                            if (hydrocarbonPV > 0) {
+                                sums[PvIdx] += hydrocarbonPV;
+                                sums[PressureIdx] += fs.pressure(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
+                                sums[RsIdx] += fs.Rs().value()*hydrocarbonPV;
+                                sums[RvIdx] += fs.Rv().value()*hydrocarbonPV;
+                                sums[TemperatureIdx] += fs.temperature(FluidSystem::oilPhaseIdx).value()*hydrocarbonPV;
+                            }
+                        }
+                        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                            exception = std::current_exception();
+                        }
                     }
                 }
+                if (exception)
+                    std::rethrow_exception(exception);
+
+                // communicate the sums of all regions at once
+                regionSums_->endSum(comm);
 
                 for (const auto& reg : rmap_.activeRegions()) {
                       auto& ra = attr_.attributes(reg);
-                      auto& p  = ra.pressure;
-                      auto& T  = ra.temperature;
-                      auto& rs  = ra.rs;
-                      auto& rv  = ra.rv;
-                      auto& pv  = ra.pv;
-                      // communicate sums
-                      p = comm.sum(p);
-                      T = comm.sum(T);
-                      rs = comm.sum(rs);
-                      rv = comm.sum(rv);
-                      pv = comm.sum(pv);
                       // compute average
-                      p /= pv;
-                      T /= pv;
-                      rs /= pv;
-                      rv /= pv;
+                      ra.pv = regionSums_->total(PvIdx, reg);
+                      ra.pressure = regionSums_->total(PressureIdx, reg) / ra.pv;
+                      ra.temperature = regionSums_->total(TemperatureIdx, reg) / ra.pv;
+                      ra.rs = regionSums_->total(RsIdx, reg) / ra.pv;
+                      ra.rv = regionSums_->total(RvIdx, reg) / ra.pv;
                 }
             }
 
@@ -766,6 +783,25 @@ namespace Opm {
 
             Details::RegionAttributes<RegionId, Attributes> attr_;
 
+            /**
+             * Sums of the cell values for the averages of each region.
+             */
+            enum { PvIdx, PressureIdx, TemperatureIdx, RsIdx, RvIdx, NumSums };
+            std::unique_ptr<RegionAggregator> regionSums_;
+
+            /**
+             * Seeds of the owned elements indexed by cell. The element type is
+             * only known in defineState(), so it is erased here.
+             */
+            struct ElementSeedsBase {
+                virtual ~ElementSeedsBase() = default;
+            };
+            template <class Seed>
+            struct ElementSeeds : public ElementSeedsBase {
+                std::vector<Seed> seeds;
+            };
+            std::unique_ptr<ElementSeedsBase> elementSeeds_;
+
         };
     } // namespace RateConverter
 } // namespace Opm
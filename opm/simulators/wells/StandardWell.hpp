@@ -40,6 +40,7 @@
 #include <dune/common/dynmatrix.hh>
 
 #include <optional>
+#include <type_traits>
 
 namespace Opm
 {
@@ -215,6 +216,8 @@ namespace Opm
 
         virtual void  addWellContributions(SparseMatrixAdapter& mat) const override;
 
+        virtual std::size_t memoryUsage() const override;
+
         /// \brief Wether the Jacobian will also have well contributions in it.
         virtual bool jacobianContainsWellContributions() const override
         {
@@ -316,6 +319,15 @@ namespace Opm
 
         EvalWell extendEval(const Eval& in) const;
 
+        // The rates of the connections are computed either with EvalWell or,
+        // if no derivatives are needed, with Scalar. This converts a
+        // reservoir or well evaluation to such a value type.
+        template <class Value, class In>
+        Value convertEval(const In& in) const;
+
+        template <class Value>
+        Value constantValue(const Scalar value) const;
+
         Eval getPerfCellPressure(const FluidState& fs) const;
 
         // xw = inv(D)*(rw - C*x)
@@ -357,13 +369,14 @@ namespace Opm
         void computeWellConnectionPressures(const Simulator& ebosSimulator,
                                                     const WellState& well_state);
 
+        template <class Value>
         void computePerfRate(const IntensiveQuantities& intQuants,
-                             const std::vector<EvalWell>& mob,
-                             const EvalWell& bhp,
+                             const std::vector<Value>& mob,
+                             const Value& bhp,
                              const double Tw,
                              const int perf,
                              const bool allow_cf,
-                             std::vector<EvalWell>& cq_s,
+                             std::vector<Value>& cq_s,
                              double& perf_dis_gas_rate,
                              double& perf_vap_oil_rate,
                              Opm::DeferredLogger& deferred_logger) const;
@@ -389,9 +402,10 @@ namespace Opm
         double calculateThpFromBhp(const std::vector<double>& rates, const double bhp, Opm::DeferredLogger& deferred_logger) const;
 
         // get the mobility for specific perforation
+        template <class Value>
         void getMobility(const Simulator& ebosSimulator,
                          const int perf,
-                         std::vector<EvalWell>& mob,
+                         std::vector<Value>& mob,
                          Opm::DeferredLogger& deferred_logger) const;
 
         void updateWaterMobilityWithPolymer(const Simulator& ebos_simulator,
@@ -322,6 +322,42 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    template<class Value, class In>
+    Value
+    StandardWell<TypeTag>::
+    convertEval(const In& in) const
+    {
+        if constexpr (std::is_same<Value, In>::value) {
+            return in;
+        } else if constexpr (std::is_same<Value, EvalWell>::value) {
+            return extendEval(in);
+        } else {
+            return in.value();
+        }
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    template<class Value>
+    Value
+    StandardWell<TypeTag>::
+    constantValue(const Scalar value) const
+    {
+        if constexpr (std::is_same<Value, EvalWell>::value) {
+            return EvalWell(numWellEq_ + numEq, value);
+        } else {
+            return value;
+        }
+    }
+
+
+
+
+
     template<typename TypeTag>
     typename StandardWell<TypeTag>::Eval
     StandardWell<TypeTag>::getPerfCellPressure(const typename StandardWell<TypeTag>::FluidState& fs) const
@@ -341,49 +377,49 @@ namespace Opm
 
 
     template<typename TypeTag>
+    template<class Value>
     void
     StandardWell<TypeTag>::
     computePerfRate(const IntensiveQuantities& intQuants,
-                    const std::vector<EvalWell>& mob,
-                    const EvalWell& bhp,
+                    const std::vector<Value>& mob,
+                    const Value& bhp,
                     const double Tw,
                     const int perf,
                     const bool allow_cf,
-                    std::vector<EvalWell>& cq_s,
+                    std::vector<Value>& cq_s,
                     double& perf_dis_gas_rate,
                     double& perf_vap_oil_rate,
                     Opm::DeferredLogger& deferred_logger) const
     {
 
         const auto& fs = intQuants.fluidState();
-        const EvalWell pressure = extendEval(getPerfCellPressure(fs));
-        const EvalWell rs = extendEval(fs.Rs());
-        const EvalWell rv = extendEval(fs.Rv());
-        std::vector<EvalWell> b_perfcells_dense(num_components_, EvalWell{numWellEq_ + numEq, 0.0});
+        const Value pressure = convertEval<Value>(getPerfCellPressure(fs));
+        const Value rs = convertEval<Value>(fs.Rs());
+        const Value rv = convertEval<Value>(fs.Rv());
+        std::vector<Value> b_perfcells_dense(num_components_, constantValue<Value>(0.0));
         for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
             if (!FluidSystem::phaseIsActive(phaseIdx)) {
                 continue;
             }
 
             const unsigned compIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-            b_perfcells_dense[compIdx] = extendEval(fs.invB(phaseIdx));
+            b_perfcells_dense[compIdx] = convertEval<Value>(fs.invB(phaseIdx));
         }
         if (has_solvent) {
-            b_perfcells_dense[contiSolventEqIdx] = extendEval(intQuants.solventInverseFormationVolumeFactor());
+            b_perfcells_dense[contiSolventEqIdx] = convertEval<Value>(intQuants.solventInverseFormationVolumeFactor());
         }
 
         // Pressure drawdown (also used to determine direction of flow)
-        const EvalWell well_pressure = bhp + perf_pressure_diffs_[perf];
-        EvalWell drawdown = pressure - well_pressure;
+        const Value well_pressure = bhp + perf_pressure_diffs_[perf];
+        Value drawdown = pressure - well_pressure;
 
         if (this->has_polymermw && this->isInjector()) {
             const int pskin_index = Bhp + 1 + number_of_perforations_ + perf;
-            const EvalWell& skin_pressure = primary_variables_evaluation_[pskin_index];
-            drawdown += skin_pressure;
+            drawdown += convertEval<Value>(primary_variables_evaluation_[pskin_index]);
         }
 
         // producing perforations
-        if ( drawdown.value() > 0 )  {
+        if ( Opm::getValue(drawdown) > 0 )  {
             //Do nothing if crossflow is not allowed
             if (!allow_cf && this->isInjector()) {
                 return;
@@ -391,25 +427,25 @@ namespace Opm
 
             // compute component volumetric rates at standard conditions
             for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
-                const EvalWell cq_p = - Tw * (mob[componentIdx] * drawdown);
+                const Value cq_p = - Tw * (mob[componentIdx] * drawdown);
                 cq_s[componentIdx] = b_perfcells_dense[componentIdx] * cq_p;
             }
 
             if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
-                const EvalWell cq_sOil = cq_s[oilCompIdx];
-                const EvalWell cq_sGas = cq_s[gasCompIdx];
-                const EvalWell dis_gas = rs * cq_sOil;
-                const EvalWell vap_oil = rv * cq_sGas;
+                const Value cq_sOil = cq_s[oilCompIdx];
+                const Value cq_sGas = cq_s[gasCompIdx];
+                const Value dis_gas = rs * cq_sOil;
+                const Value vap_oil = rv * cq_sGas;
 
                 cq_s[gasCompIdx] += dis_gas;
                 cq_s[oilCompIdx] += vap_oil;
 
                 // recording the perforation solution gas rate and solution oil rates
                 if (this->isProducer()) {
-                    perf_dis_gas_rate = dis_gas.value();
-                    perf_vap_oil_rate = vap_oil.value();
+                    perf_dis_gas_rate = Opm::getValue(dis_gas);
+                    perf_vap_oil_rate = Opm::getValue(vap_oil);
                 }
             }
 
@@ -420,22 +456,22 @@ namespace Opm
             }
 
             // Using total mobilities
-            EvalWell total_mob_dense = mob[0];
+            Value total_mob_dense = mob[0];
             for (int componentIdx = 1; componentIdx < num_components_; ++componentIdx) {
                 total_mob_dense += mob[componentIdx];
             }
 
             // injection perforations total volume rates
-            const EvalWell cqt_i = - Tw * (total_mob_dense * drawdown);
+            const Value cqt_i = - Tw * (total_mob_dense * drawdown);
 
             // surface volume fraction of fluids within wellbore
-            std::vector<EvalWell> cmix_s(num_components_, EvalWell{numWellEq_ + numEq});
+            std::vector<Value> cmix_s(num_components_, constantValue<Value>(0.0));
             for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
-                cmix_s[componentIdx] = wellSurfaceVolumeFraction(componentIdx);
+                cmix_s[componentIdx] = convertEval<Value>(wellSurfaceVolumeFraction(componentIdx));
             }
 
             // compute volume ratio between connection at standard conditions
-            EvalWell volumeRatio(numWellEq_ + numEq, 0.);
+            Value volumeRatio = constantValue<Value>(0.0);
             if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
                 const unsigned waterCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::waterCompIdx);
                 volumeRatio += cmix_s[waterCompIdx] / b_perfcells_dense[waterCompIdx];
@@ -449,18 +485,18 @@ namespace Opm
                 const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
                 const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
                 // Incorporate RS/RV factors if both oil and gas active
-                const EvalWell d = EvalWell(numWellEq_ + numEq, 1.0) - rv * rs;
+                const Value d = constantValue<Value>(1.0) - rv * rs;
 
-                if (d.value() == 0.0) {
+                if (Opm::getValue(d) == 0.0) {
                     OPM_DEFLOG_THROW(Opm::NumericalIssue, "Zero d value obtained for well " << name() << " during flux calcuation"
                                                   << " with rs " << rs << " and rv " << rv, deferred_logger);
                 }
 
-                const EvalWell tmp_oil = (cmix_s[oilCompIdx] - rv * cmix_s[gasCompIdx]) / d;
+                const Value tmp_oil = (cmix_s[oilCompIdx] - rv * cmix_s[gasCompIdx]) / d;
                 //std::cout << "tmp_oil " <<tmp_oil << std::endl;
                 volumeRatio += tmp_oil / b_perfcells_dense[oilCompIdx];
 
-                const EvalWell tmp_gas = (cmix_s[gasCompIdx] - rs * cmix_s[oilCompIdx]) / d;
+                const Value tmp_gas = (cmix_s[gasCompIdx] - rs * cmix_s[oilCompIdx]) / d;
                 //std::cout << "tmp_gas " <<tmp_gas << std::endl;
                 volumeRatio += tmp_gas / b_perfcells_dense[gasCompIdx];
             }
@@ -476,7 +512,7 @@ namespace Opm
             }
 
             // injecting connections total volumerates at standard conditions
-            EvalWell cqt_is = cqt_i/volumeRatio;
+            Value cqt_is = cqt_i/volumeRatio;
             //std::cout << "volrat " << volumeRatio << " " << volrat_perf_[perf] << std::endl;
             for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
                 cq_s[componentIdx] = cmix_s[componentIdx] * cqt_is; // * b_perfcells_dense[phase];
@@ -495,13 +531,13 @@ namespace Opm
                     // q_or = 1 / (b_o * d) * (q_os - rv * q_gs)
                     // q_gr = 1 / (b_g * d) * (q_gs - rs * q_os)
 
-                    const double d = 1.0 - rv.value() * rs.value();
+                    const double d = 1.0 - Opm::getValue(rv) * Opm::getValue(rs);
                     // vaporized oil into gas
                     // rv * q_gr * b_g = rv * (q_gs - rs * q_os) / d
-                    perf_vap_oil_rate = rv.value() * (cq_s[gasCompIdx].value() - rs.value() * cq_s[oilCompIdx].value()) / d;
+                    perf_vap_oil_rate = Opm::getValue(rv) * (Opm::getValue(cq_s[gasCompIdx]) - Opm::getValue(rs) * Opm::getValue(cq_s[oilCompIdx])) / d;
                     // dissolved of gas in oil
                     // rs * q_or * b_o = rs * (q_os - rv * q_gs) / d
-                    perf_dis_gas_rate = rs.value() * (cq_s[oilCompIdx].value() - rv.value() * cq_s[gasCompIdx].value()) / d;
+                    perf_dis_gas_rate = Opm::getValue(rs) * (Opm::getValue(cq_s[oilCompIdx]) - Opm::getValue(rv) * Opm::getValue(cq_s[gasCompIdx])) / d;
                 }
             }
         }
@@ -824,13 +860,27 @@ namespace Opm
 
 
     template<typename TypeTag>
+    template<class Value>
     void
     StandardWell<TypeTag>::
     getMobility(const Simulator& ebosSimulator,
                 const int perf,
-                std::vector<EvalWell>& mob,
+                std::vector<Value>& mob,
                 Opm::DeferredLogger& deferred_logger) const
     {
+        if constexpr (!std::is_same<Value, EvalWell>::value) {
+            // the polymer modification of the water mobility is only
+            // implemented with the well's evaluations
+            if (has_polymer) {
+                std::vector<EvalWell> mob_eval(num_components_, {numWellEq_ + numEq, 0.});
+                getMobility(ebosSimulator, perf, mob_eval, deferred_logger);
+                for (int componentIdx = 0; componentIdx < num_components_; ++componentIdx) {
+                    mob[componentIdx] = mob_eval[componentIdx].value();
+                }
+                return;
+            }
+        }
+
         const int cell_idx = well_cells_[perf];
         assert (int(mob.size()) == num_components_);
         const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/0));
@@ -848,10 +898,10 @@ namespace Opm
                 }
 
                 const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-                mob[activeCompIdx] = extendEval(intQuants.mobility(phaseIdx));
+                mob[activeCompIdx] = convertEval<Value>(intQuants.mobility(phaseIdx));
             }
             if (has_solvent) {
-                mob[contiSolventEqIdx] = extendEval(intQuants.solventMobility());
+                mob[contiSolventEqIdx] = convertEval<Value>(intQuants.solventMobility());
             }
         } else {
 
@@ -869,7 +919,7 @@ namespace Opm
                 }
 
                 const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-                mob[activeCompIdx] = extendEval(relativePerms[phaseIdx] / intQuants.fluidState().viscosity(phaseIdx));
+                mob[activeCompIdx] = convertEval<Value>(relativePerms[phaseIdx] / intQuants.fluidState().viscosity(phaseIdx));
             }
 
             // this may not work if viscosity and relperms has been modified?
@@ -879,12 +929,14 @@ namespace Opm
         }
 
         // modify the water mobility if polymer is present
-        if (has_polymer) {
-            if (!FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
-                OPM_DEFLOG_THROW(std::runtime_error, "Water is required when polymer is active", deferred_logger);
-            }
+        if constexpr (std::is_same<Value, EvalWell>::value) {
+            if (has_polymer) {
+                if (!FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+                    OPM_DEFLOG_THROW(std::runtime_error, "Water is required when polymer is active", deferred_logger);
+                }
 
-            updateWaterMobilityWithPolymer(ebosSimulator, perf, mob, deferred_logger);
+                updateWaterMobilityWithPolymer(ebosSimulator, perf, mob, deferred_logger);
+            }
         }
     }
 
@@ -1460,7 +1512,7 @@ namespace Opm
         std::fill(ipr_b_.begin(), ipr_b_.end(), 0.);
 
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
-            std::vector<EvalWell> mob(num_components_, {numWellEq_ + numEq, 0.0});
+            std::vector<Scalar> mob(num_components_, 0.0);
             // TODO: mabye we should store the mobility somewhere, so that we only need to calculate it one per iteration
             getMobility(ebos_simulator, perf, mob, deferred_logger);
 
@@ -1502,7 +1554,7 @@ namespace Opm
             std::vector<double> ipr_a_perf(ipr_a_.size());
             std::vector<double> ipr_b_perf(ipr_b_.size());
             for (int p = 0; p < number_of_phases_; ++p) {
-                const double tw_mob = tw_perf * mob[p].value() * b_perf[p];
+                const double tw_mob = tw_perf * mob[p] * b_perf[p];
                 ipr_a_perf[p] += tw_mob * pressure_diff;
                 ipr_b_perf[p] += tw_mob;
             }
@@ -1571,18 +1623,23 @@ namespace Opm
 
         const bool well_operable = this->operability_status_.isOperable();
 
+        // these messages are checked in every iteration, so they use interned
+        // templates which are only formatted when they are logged
+        static const int shutMessage = DeferredLogger::messageTemplate("", " well {} gets SHUT during iteration ");
+        static const int stoppedMessage = DeferredLogger::messageTemplate("", " well {} gets STOPPED during iteration ");
+        static const int revivedMessage = DeferredLogger::messageTemplate("", " well {} gets REVIVED during iteration ");
         if (!well_operable && old_well_operable) {
             if (well_ecl_.getAutomaticShutIn()) {
-                deferred_logger.info(" well " + name() + " gets SHUT during iteration ");
+                deferred_logger.info(shutMessage, name());
             } else {
                 if (!this->wellIsStopped()) {
-                    deferred_logger.info(" well " + name() + " gets STOPPED during iteration ");
+                    deferred_logger.info(stoppedMessage, name());
                     this->stopWell();
                     changed_to_stopped_this_step_ = true;
                 }
             }
         } else if (well_operable && !old_well_operable) {
-            deferred_logger.info(" well " + name() + " gets REVIVED during iteration ");
+            deferred_logger.info(revivedMessage, name());
             this->openWell();
             changed_to_stopped_this_step_ = false;
         }
@@ -1688,20 +1745,19 @@ namespace Opm
 
             const double thp_limit = this->getTHPConstraint(summaryState);
             if (*obtain_bhp < thp_limit) {
-                const std::string msg = " obtained bhp " + std::to_string(unit::convert::to(*obtain_bhp, unit::barsa))
-                                        + " bars is SMALLER than thp limit "
-                                        + std::to_string(unit::convert::to(thp_limit, unit::barsa))
-                                        + " bars as a producer for well " + name();
-                deferred_logger.debug(msg);
+                static const int message = DeferredLogger::messageTemplate("",
+                    " obtained bhp {} bars is SMALLER than thp limit {} bars as a producer for well {}");
+                deferred_logger.debug(message, unit::convert::to(*obtain_bhp, unit::barsa),
+                                      unit::convert::to(thp_limit, unit::barsa), name());
             }
         } else {
             this->operability_status_.can_obtain_bhp_with_thp_limit = false;
             this->operability_status_.obey_bhp_limit_with_thp_limit = false;
             if (!this->wellIsStopped()) {
                 const double thp_limit = this->getTHPConstraint(summaryState);
-                deferred_logger.debug(" could not find bhp value at thp limit "
-                                      + std::to_string(unit::convert::to(thp_limit, unit::barsa))
-                                      + " bar for well " + name() + ", the well might need to be closed ");
+                static const int message = DeferredLogger::messageTemplate("",
+                    " could not find bhp value at thp limit {} bar for well {}, the well might need to be closed ");
+                deferred_logger.debug(message, unit::convert::to(thp_limit, unit::barsa), name());
             }
         }
     }
@@ -1771,7 +1827,8 @@ namespace Opm
         }
 
         if (!can_produce_inject) {
-            deferred_logger.debug(" well " + name() + " CANNOT produce or inejct ");
+            static const int message = DeferredLogger::messageTemplate("", " well {} CANNOT produce or inejct ");
+            deferred_logger.debug(message, name());
         }
 
         return can_produce_inject;
@@ -2407,20 +2464,20 @@ namespace Opm
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
             const int cell_idx = well_cells_[perf];
             const auto& intQuants = *(ebosSimulator.model().cachedIntensiveQuantities(cell_idx, /*timeIdx=*/ 0));
-            // flux for each perforation
-            std::vector<EvalWell> mob(num_components_, {numWellEq_ + numEq, 0.});
+            // flux for each perforation, no derivatives are needed
+            std::vector<Scalar> mob(num_components_, 0.);
             getMobility(ebosSimulator, perf, mob, deferred_logger);
             double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants, cell_idx);
             const double Tw = well_index_[perf] * trans_mult;
 
-            std::vector<EvalWell> cq_s(num_components_, {numWellEq_ + numEq, 0.});
+            std::vector<Scalar> cq_s(num_components_, 0.);
             double perf_dis_gas_rate = 0.;
             double perf_vap_oil_rate = 0.;
-            computePerfRate(intQuants, mob, EvalWell(numWellEq_ + numEq, bhp), Tw, perf, allow_cf,
+            computePerfRate(intQuants, mob, Scalar(bhp), Tw, perf, allow_cf,
                             cq_s, perf_dis_gas_rate, perf_vap_oil_rate, deferred_logger);
 
             for(int p = 0; p < np; ++p) {
-                well_flux[ebosCompIdxToFlowCompIdx(p)] += cq_s[p].value();
+                well_flux[ebosCompIdxToFlowCompIdx(p)] += cq_s[p];
             }
         }
     }
@@ -2829,6 +2886,18 @@ namespace Opm
         }
     }
 
+    template<typename TypeTag>
+    std::size_t
+    StandardWell<TypeTag>::memoryUsage() const
+    {
+        return matrixMemoryUsage(duneB_) + matrixMemoryUsage(duneC_) + matrixMemoryUsage(invDuneD_)
+            + (resWell_.size() + Bx_.size() + invDrw_.size()) * sizeof(typename BVectorWell::block_type);
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::addWellContributions(SparseMatrixAdapter& jacobian) const
@@ -3429,7 +3498,20 @@ namespace Opm
         };
 
         // Make the frates() function.
-        auto frates = [this, &ebos_simulator, &deferred_logger](const double bhp) {
+        // Every evaluation is a sweep over all perforations, and the
+        // same bhp values are requested repeatedly (bracket end points
+        // of the root finder, the bhp samples), so the results are kept
+        // for the duration of this call. They are not kept between calls,
+        // the rates depend on the cached intensive quantities and on the
+        // connection pressure differences, which are not versioned.
+        std::vector<std::pair<double, std::vector<double>>> frates_cache;
+        int num_frates_evaluations = 0;
+        auto frates = [this, &ebos_simulator, &deferred_logger, &frates_cache, &num_frates_evaluations](const double bhp) {
+            for (const auto& entry : frates_cache) {
+                if (entry.first == bhp) {
+                    return entry.second;
+                }
+            }
             // Not solving the well equations here, which means we are
             // calculating at the current Fg/Fw values of the
             // well. This does not matter unless the well is
@@ -3437,6 +3519,8 @@ namespace Opm
             // approximation.
             std::vector<double> rates(3);
             computeWellRatesWithBhp(ebos_simulator, bhp, rates, deferred_logger);
+            ++num_frates_evaluations;
+            frates_cache.emplace_back(bhp, rates);
             return rates;
         };
 
@@ -3457,6 +3541,38 @@ namespace Opm
             x = -x;
         }
 
+        // The linear IPR of the well, rates = -(ipr_a - ipr_b * bhp), gives
+        // an affine approximation to flo(frates(bhp)) which can be inverted
+        // directly. Its solution is used to find a narrow bracket for the
+        // root finder, and only if the bracket does not contain the root
+        // the full bhp range is searched.
+        auto frates_ipr = [this](const double bhp) {
+            std::vector<double> rates(3, 0.0);
+            for (int p = 0; p < number_of_phases_; ++p) {
+                rates[p] = -(ipr_a_[p] - ipr_b_[p] * bhp);
+            }
+            return rates;
+        };
+        const double flo_ipr_zero = flo(frates_ipr(0.0));
+        const double flo_ipr_slope = flo(frates_ipr(1.0)) - flo_ipr_zero;
+        auto solve_with_ipr_bracket = [&flo_ipr_zero, &flo_ipr_slope](const auto& eq, const double flo_sample,
+                                                                      const double low, const double high,
+                                                                      const int max_iteration, const double tolerance,
+                                                                      int& iteration) {
+            if (flo_ipr_slope > 0.0) {
+                const double guess = (flo_sample - flo_ipr_zero) / flo_ipr_slope;
+                const double delta = std::max(0.02 * guess, 1.0 * unit::barsa);
+                const double bracket_low = std::max(low, guess - delta);
+                const double bracket_high = std::min(high, guess + delta);
+                if (bracket_low < bracket_high && eq(bracket_low) * eq(bracket_high) <= 0.0) {
+                    return RegulaFalsiBisection<>::
+                        solve(eq, bracket_low, bracket_high, max_iteration, tolerance, iteration);
+                }
+            }
+            return RegulaFalsiBisection<>::
+                solve(eq, low, high, max_iteration, tolerance, iteration);
+        };
+
         // Find bhp values for inflow relation corresponding to flo samples.
         std::vector<double> bhp_samples;
         for (double flo_sample : flo_samples) {
@@ -3479,8 +3595,8 @@ namespace Opm
             const double flo_tolerance = 1e-6 * std::fabs(flo_samples.back());
             int iteration = 0;
             try {
-                const double solved_bhp = RegulaFalsiBisection<>::
-                    solve(eq, low, high, max_iteration, flo_tolerance, iteration);
+                const double solved_bhp = solve_with_ipr_bracket(eq, flo_sample, low, high,
+                                                                 max_iteration, flo_tolerance, iteration);
                 bhp_samples.push_back(solved_bhp);
             }
             catch (...) {
@@ -3555,7 +3671,8 @@ namespace Opm
                 solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
 #ifdef EXTRA_THP_DEBUGGING
             OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                          + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
+                          + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit)
+                          + "    frates evaluations = " + std::to_string(num_frates_evaluations));
 #endif // EXTRA_THP_DEBUGGING
             return solved_bhp;
         }
@@ -3634,7 +3751,20 @@ namespace Opm
         };
 
         // Make the frates() function.
-        auto frates = [this, &ebos_simulator, &deferred_logger](const double bhp) {
+        // Every evaluation is a sweep over all perforations, and the
+        // same bhp values are requested repeatedly (bracket end points
+        // of the root finder, the bhp samples), so the results are kept
+        // for the duration of this call. They are not kept between calls,
+        // the rates depend on the cached intensive quantities and on the
+        // connection pressure differences, which are not versioned.
+        std::vector<std::pair<double, std::vector<double>>> frates_cache;
+        int num_frates_evaluations = 0;
+        auto frates = [this, &ebos_simulator, &deferred_logger, &frates_cache, &num_frates_evaluations](const double bhp) {
+            for (const auto& entry : frates_cache) {
+                if (entry.first == bhp) {
+                    return entry.second;
+                }
+            }
             // Not solving the well equations here, which means we are
             // calculating at the current Fg/Fw values of the
             // well. This does not matter unless the well is
@@ -3642,6 +3772,8 @@ namespace Opm
             // approximation.
             std::vector<double> rates(3);
             computeWellRatesWithBhp(ebos_simulator, bhp, rates, deferred_logger);
+            ++num_frates_evaluations;
+            frates_cache.emplace_back(bhp, rates);
             return rates;
         };
 
@@ -3755,7 +3887,8 @@ namespace Opm
                     solve(eq, low, high, max_iteration, bhp_tolerance, iteration);
 #ifdef EXTRA_THP_DEBUGGING
             OpmLog::debug("*****    " + name() + "    solved_bhp = " + std::to_string(solved_bhp)
-                          + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit));
+                          + "    flo_bhp_limit = " + std::to_string(flo_bhp_limit)
+                          + "    frates evaluations = " + std::to_string(num_frates_evaluations));
 #endif // EXTRA_THP_DEBUGGING
             return solved_bhp;
         }
@@ -44,6 +44,7 @@
 
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
 #include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/utils/MemoryReport.hpp>
 
 #include<dune/common/fmatrix.hh>
 #include<dune/istl/bcrsmatrix.hh>
@@ -225,6 +226,9 @@ namespace Opm
         // Add well contributions to matrix
         virtual void addWellContributions(SparseMatrixAdapter&) const = 0;
 
+        // Number of bytes held by the linear system of the well
+        virtual std::size_t memoryUsage() const = 0;
+
         void addCellRates(RateVector& rates, int cellIdx) const;
 
         Scalar volumetricSurfaceRateForConnection(int cellIdx, int phaseIdx) const;
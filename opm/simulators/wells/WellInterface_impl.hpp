@@ -476,12 +476,9 @@ namespace Opm
         const auto& summaryState = ebos_simulator.vanguard().summaryState();
         const auto& schedule = ebos_simulator.vanguard().schedule();
         const auto& well = well_ecl_;
-        std::string from;
-        if (well.isInjector()) {
-            from = Well::InjectorCMode2String(well_state.currentInjectionControls()[index_of_well_]);
-        } else {
-            from = Well::ProducerCMode2String(well_state.currentProductionControls()[index_of_well_]);
-        }
+        // the names of the modes are only needed if the control changes
+        const auto fromInjection = well_state.currentInjectionControls()[index_of_well_];
+        const auto fromProduction = well_state.currentProductionControls()[index_of_well_];
 
         bool changed = false;
         if (iog == IndividualOrGroup::Individual) {
@@ -497,20 +494,24 @@ namespace Opm
 
         // checking whether control changed
         if (changed) {
+            std::string from;
             std::string to;
             if (well.isInjector()) {
+                from = Well::InjectorCMode2String(fromInjection);
                 to = Well::InjectorCMode2String(well_state.currentInjectionControls()[index_of_well_]);
             } else {
+                from = Well::ProducerCMode2String(fromProduction);
                 to = Well::ProducerCMode2String(well_state.currentProductionControls()[index_of_well_]);
             }
-            std::ostringstream ss;
-            ss << "    Switching control mode for well " << name()
-               << " from " << from
-               << " to " <<  to;
+            static const int message = DeferredLogger::messageTemplate("",
+                "    Switching control mode for well {} from {} to {}");
+            static const int parallelMessage = DeferredLogger::messageTemplate("",
+                "    Switching control mode for well {} from {} to {} on rank {}");
             if (cc.size() > 1) {
-               ss << " on rank " << cc.rank();
+                deferred_logger.info(parallelMessage, name(), from, to, cc.rank());
+            } else {
+                deferred_logger.info(message, name(), from, to);
             }
-            deferred_logger.info(ss.str());
             updateWellStateWithTarget(ebos_simulator, well_state, deferred_logger);
             updatePrimaryVariables(well_state, deferred_logger);
         }
@@ -1366,12 +1367,15 @@ namespace Opm
         // keep a copy of the original well state
         const WellState well_state0 = well_state;
         const bool converged = solveWellEqUntilConverged(ebosSimulator, B_avg, well_state, deferred_logger);
+        static const int convergedMessage = DeferredLogger::messageTemplate("",
+            "WellTest: Well equation for well {} converged");
+        static const int failedMessage = DeferredLogger::messageTemplate("",
+            "WellTest: Well equation for well {} failed converging in {} iterations");
         if (converged) {
-            deferred_logger.debug("WellTest: Well equation for well " + name() +  " converged");
+            deferred_logger.debug(convergedMessage, name());
         } else {
             const int max_iter = param_.max_welleq_iter_;
-            deferred_logger.debug("WellTest: Well equation for well " +name() + " failed converging in "
-                          + std::to_string(max_iter) + " iterations");
+            deferred_logger.debug(failedMessage, name(), max_iter);
             well_state = well_state0;
         }
     }
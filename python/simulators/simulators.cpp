@@ -1,20 +1,40 @@
 #include "config.h"
+
+// The report steps are instantiated in this module when the simulator is
+// stepped from Python, so it needs the same setup as flow_ebos_blackoil.cpp.
+#define FLOW_SUPPORT_AMG 1
+
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #define FLOW_BLACKOIL_ONLY
 #include <opm/simulators/flow/Main.hpp>
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/core/props/phaseUsageFromDeck.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/embed.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <array>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace py = pybind11;
 
 class BlackOilSimulator
 {
 public:
+    typedef TTAG(EclFlowProblem) TypeTag;
+    typedef GET_PROP_TYPE(TypeTag, Simulator) Simulator;
+    typedef GET_PROP_TYPE(TypeTag, ElementContext) ElementContext;
+    typedef GET_PROP_TYPE(TypeTag, FluidSystem) FluidSystem;
+    typedef GET_PROP_TYPE(TypeTag, Indices) Indices;
+    typedef GET_PROP_TYPE(TypeTag, PrimaryVariables) PrimaryVariables;
 
     BlackOilSimulator( const std::string &deckFilename) : deckFilename_(deckFilename)
     {
@@ -25,14 +45,273 @@ public:
         auto mainObject = Opm::Main( deckFilename_ );
         return mainObject.runDynamic();
     }
-    
+
+    // Read the deck and set up the simulation up to the first report step.
+    void setup()
+    {
+        if (main_)
+            throw std::logic_error("The simulation has already been set up");
+
+        main_ = std::make_unique<Opm::Main>(deckFilename_);
+        int exitCode = EXIT_SUCCESS;
+        mainEbos_ = main_->initFlowEbosBlackoil(exitCode);
+        if (!mainEbos_)
+            throw std::runtime_error("Setting up the simulation of " + deckFilename_
+                                     + " failed with exit code " + std::to_string(exitCode));
+
+        // The buffers for the quantities which are not stored per cell by the
+        // simulator are allocated once, so the arrays returned by the getters
+        // stay valid and are updated in place after each step.
+        auto& simulator = simulator_();
+        const std::size_t numCells = simulator.model().numGridDof();
+        for (auto& saturation : saturation_)
+            saturation.assign(numCells, 0.0);
+        rs_.assign(numCells, 0.0);
+        rv_.assign(numCells, 0.0);
+
+        phaseUsage_ = Opm::phaseUsageFromDeck(simulator.vanguard().eclState());
+        wellNames_ = simulator.vanguard().schedule().wellNames();
+        wellRates_.assign(wellNames_.size() * numWellRatePhases, 0.0);
+        ++stateVersion_;
+    }
+
+    // Run the next report step.
+    void step()
+    {
+        checkRunning_();
+        if (!mainEbos_->hasMoreSteps())
+            throw std::logic_error("All report steps have already been run");
+
+        const int result = mainEbos_->executeStep();
+        ++stateVersion_;
+        if (result != EXIT_SUCCESS)
+            throw std::runtime_error("Running the report step failed");
+    }
+
+    // Write the remaining output and print the final report. The state of the
+    // simulator is kept, so it can still be inspected.
+    int stepCleanup()
+    {
+        checkRunning_();
+        finished_ = true;
+        return mainEbos_->executeStepsCleanup();
+    }
+
+    bool hasMoreSteps() const
+    { return mainEbos_ && !finished_ && mainEbos_->hasMoreSteps(); }
+
+    // The pressure primary variable of each cell, a view into the solution
+    // vector of the simulator.
+    py::array_t<double> getPressure()
+    {
+        const auto& solution = simulator_().model().solution(/*timeIdx=*/0);
+        const double* data = &solution[0][Indices::pressureSwitchIdx];
+        return view_(data, {static_cast<py::ssize_t>(solution.size())},
+                     {static_cast<py::ssize_t>(sizeof(PrimaryVariables))});
+    }
+
+    // The saturation of a phase ("water", "oil" or "gas") in each cell.
+    py::array_t<double> getSaturation(const std::string& phase)
+    {
+        const unsigned phaseIdx = phaseIndex_(phase);
+        updateCellBuffers_();
+        return view_(saturation_[phaseIdx]);
+    }
+
+    py::array_t<double> getRs()
+    {
+        updateCellBuffers_();
+        return view_(rs_);
+    }
+
+    py::array_t<double> getRv()
+    {
+        updateCellBuffers_();
+        return view_(rv_);
+    }
+
+    // The reference porosity of each cell, a view into the array used by the
+    // simulator.
+    py::array_t<double> getPorosity()
+    {
+        return view_(simulator_().problem().referencePorosity(/*timeIdx=*/0));
+    }
+
+    void setPorosity(py::array_t<double, py::array::c_style | py::array::forcecast> porosity)
+    {
+        simulator_().problem().setReferencePorosity(porosity.data(), porosity.size());
+        ++stateVersion_;
+    }
+
+    // The surface rates of the wells of getWellNames() for water, oil and gas in
+    // SI units, positive for injection. Rates of phases which are not active and
+    // of wells which are not open are zero.
+    py::array_t<double> getWellRates()
+    {
+        updateWellBuffers_();
+        return view_(wellRates_.data(),
+                     {static_cast<py::ssize_t>(wellNames_.size()), static_cast<py::ssize_t>(numWellRatePhases)},
+                     {static_cast<py::ssize_t>(numWellRatePhases * sizeof(double)),
+                      static_cast<py::ssize_t>(sizeof(double))});
+    }
+
+    const std::vector<std::string>& getWellNames()
+    {
+        checkSetup_();
+        return wellNames_;
+    }
+
+    // Control a well by the given mode (e.g. "ORAT" or "BHP") and target in SI
+    // units from the next report step on.
+    void setProducerTarget(const std::string& wellName, const std::string& cmode, double target)
+    {
+        simulator_().problem().wellModel().setWellTarget(wellName, Opm::Well::ProducerCModeFromString(cmode), target);
+    }
+
+    void setInjectorTarget(const std::string& wellName, const std::string& cmode, double target)
+    {
+        simulator_().problem().wellModel().setWellTarget(wellName, Opm::Well::InjectorCModeFromString(cmode), target);
+    }
+
 private:
+    static constexpr int numWellRatePhases = 3;
+
+    Simulator& simulator_()
+    {
+        checkSetup_();
+        return *mainEbos_->getSimulatorPtr();
+    }
+
+    void checkSetup_() const
+    {
+        if (!mainEbos_)
+            throw std::logic_error("The simulation has not been set up, call setup() first");
+    }
+
+    void checkRunning_() const
+    {
+        checkSetup_();
+        if (finished_)
+            throw std::logic_error("The simulation has already been finished by stepCleanup()");
+    }
+
+    static unsigned phaseIndex_(const std::string& phase)
+    {
+        unsigned phaseIdx;
+        if (phase == "water")
+            phaseIdx = FluidSystem::waterPhaseIdx;
+        else if (phase == "oil")
+            phaseIdx = FluidSystem::oilPhaseIdx;
+        else if (phase == "gas")
+            phaseIdx = FluidSystem::gasPhaseIdx;
+        else
+            throw std::invalid_argument("Unknown phase '" + phase + "', valid are water, oil and gas");
+
+        if (!FluidSystem::phaseIsActive(phaseIdx))
+            throw std::invalid_argument("The phase '" + phase + "' is not active");
+        return phaseIdx;
+    }
+
+    // A read-only array over the memory of the simulator, which keeps this
+    // object alive.
+    py::array_t<double> view_(const double* data, std::vector<py::ssize_t> shape, std::vector<py::ssize_t> strides)
+    {
+        py::array_t<double> result(std::move(shape), std::move(strides), data, py::cast(this));
+        result.attr("setflags")(py::arg("write") = false);
+        return result;
+    }
+
+    py::array_t<double> view_(const std::vector<double>& data)
+    {
+        return view_(data.data(), {static_cast<py::ssize_t>(data.size())},
+                     {static_cast<py::ssize_t>(sizeof(double))});
+    }
+
+    void updateCellBuffers_()
+    {
+        if (cellBufferVersion_ == stateVersion_)
+            return;
+
+        auto& simulator = simulator_();
+        const auto& gridView = simulator.vanguard().gridView();
+        ElementContext elemCtx(simulator);
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (auto elemIt = gridView.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+            elemCtx.updatePrimaryStencil(*elemIt);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+
+            const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            const auto& fs = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0).fluidState();
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                if (FluidSystem::phaseIsActive(phaseIdx))
+                    saturation_[phaseIdx][cellIdx] = Opm::getValue(fs.saturation(phaseIdx));
+            }
+            rs_[cellIdx] = Opm::getValue(fs.Rs());
+            rv_[cellIdx] = Opm::getValue(fs.Rv());
+        }
+        cellBufferVersion_ = stateVersion_;
+    }
+
+    void updateWellBuffers_()
+    {
+        if (wellBufferVersion_ == stateVersion_)
+            return;
+
+        std::fill(wellRates_.begin(), wellRates_.end(), 0.0);
+        const auto& wellState = simulator_().problem().wellModel().wellState();
+        const int np = phaseUsage_.num_phases;
+        for (std::size_t row = 0; row < wellNames_.size(); ++row) {
+            const auto well = wellState.wellMap().find(wellNames_[row]);
+            if (well == wellState.wellMap().end())
+                continue;
+
+            const int w = well->second[0];
+            for (int p = 0; p < numWellRatePhases; ++p) {
+                if (phaseUsage_.phase_used[p])
+                    wellRates_[numWellRatePhases*row + p] = wellState.wellRates()[np*w + phaseUsage_.phase_pos[p]];
+            }
+        }
+        wellBufferVersion_ = stateVersion_;
+    }
+
     const std::string deckFilename_;
+    std::unique_ptr<Opm::Main> main_;
+    std::unique_ptr<Opm::FlowMainEbos<TypeTag>> mainEbos_;
+    bool finished_ = false;
+
+    Opm::PhaseUsage phaseUsage_;
+    std::vector<std::string> wellNames_;
+
+    // buffers of the quantities which are computed from the solution,
+    // refreshed when stateVersion_ changed
+    unsigned long stateVersion_ = 0;
+    unsigned long cellBufferVersion_ = 0;
+    unsigned long wellBufferVersion_ = 0;
+    std::array<std::vector<double>, FluidSystem::numPhases> saturation_;
+    std::vector<double> rs_;
+    std::vector<double> rv_;
+    std::vector<double> wellRates_;
 };
 
 PYBIND11_MODULE(simulators, m)
 {
     py::class_<BlackOilSimulator>(m, "BlackOilSimulator")
         .def(py::init< const std::string& >())
-        .def("run", &BlackOilSimulator::run);
+        .def("run", &BlackOilSimulator::run)
+        .def("setup", &BlackOilSimulator::setup)
+        .def("step", &BlackOilSimulator::step)
+        .def("stepCleanup", &BlackOilSimulator::stepCleanup)
+        .def("hasMoreSteps", &BlackOilSimulator::hasMoreSteps)
+        .def("getPressure", &BlackOilSimulator::getPressure)
+        .def("getSaturation", &BlackOilSimulator::getSaturation, py::arg("phase"))
+        .def("getRs", &BlackOilSimulator::getRs)
+        .def("getRv", &BlackOilSimulator::getRv)
+        .def("getPorosity", &BlackOilSimulator::getPorosity)
+        .def("setPorosity", &BlackOilSimulator::setPorosity, py::arg("porosity"))
+        .def("getWellRates", &BlackOilSimulator::getWellRates)
+        .def("getWellNames", &BlackOilSimulator::getWellNames)
+        .def("setProducerTarget", &BlackOilSimulator::setProducerTarget,
+             py::arg("well"), py::arg("cmode"), py::arg("target"))
+        .def("setInjectorTarget", &BlackOilSimulator::setInjectorTarget,
+             py::arg("well"), py::arg("cmode"), py::arg("target"));
 }
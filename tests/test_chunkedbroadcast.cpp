@@ -0,0 +1,133 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestChunkedBroadcast
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/eclmpiserializer.hh>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entry
+{
+    std::string name;
+    double value = 0.0;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(name);
+        serializer(value);
+    }
+
+    bool operator==(const Entry& other) const
+    {
+        return name == other.name && value == other.value;
+    }
+};
+
+struct State
+{
+    std::vector<double> table;
+    std::string title;
+    std::vector<Entry> entries;
+    std::map<std::string, Entry> named;
+    std::shared_ptr<Entry> optional;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(table);
+        serializer(title);
+        serializer.vector(entries);
+        serializer.map(named);
+        serializer(optional);
+    }
+};
+
+State makeState(const int tableSize)
+{
+    State state;
+    for (int i = 0; i < tableSize; ++i)
+        state.table.push_back(0.5*i);
+    state.title = "chunked broadcast";
+    for (int i = 0; i < 50; ++i)
+        state.entries.push_back({"entry" + std::to_string(i), 1.5*i});
+    for (int i = 0; i < 20; ++i)
+        state.named["key" + std::to_string(i)] = {"named" + std::to_string(i), double(i)};
+    state.optional = std::make_shared<Entry>(Entry{"optional", 3.0});
+    return state;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ChunkSizes)
+{
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+
+    // the small chunk sizes split single items across several chunks
+    for (const std::size_t chunkSize : {16u, 40u, 100u, 1000u, 1u << 20}) {
+        for (const int tableSize : {0, 3, 1000}) {
+            const State expected = makeState(tableSize);
+            State state;
+            if (comm.rank() == 0)
+                state = expected;
+
+            Opm::EclMpiSerializer ser(comm);
+            ser.setChunkSize(chunkSize);
+            ser.broadcast(state);
+
+            BOOST_CHECK(state.table == expected.table);
+            BOOST_CHECK_EQUAL(state.title, expected.title);
+            BOOST_CHECK(state.entries == expected.entries);
+            BOOST_CHECK(state.named == expected.named);
+            BOOST_REQUIRE(state.optional);
+            BOOST_CHECK(*state.optional == *expected.optional);
+
+            // the serializer can be used for further broadcasts
+            State other;
+            if (comm.rank() == 0)
+                other.title = "again";
+            ser.broadcast(other);
+            BOOST_CHECK_EQUAL(other.title, "again");
+        }
+    }
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -33,6 +33,8 @@
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
 
+#include <chrono>
+
 using namespace Opm;
 
 void initLogger(std::ostringstream& log_stream) {
@@ -98,3 +100,91 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     BOOST_CHECK_EQUAL(log_stream.str(), expected);
 
 }
+
+BOOST_AUTO_TEST_CASE(appendMessages)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Info, "info 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Warning, "warning 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "info 2") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    auto deferred_logger = Opm::DeferredLogger();
+    auto other_logger = Opm::DeferredLogger();
+    deferred_logger.info("info 1");
+    other_logger.warning("warning 1");
+    other_logger.info("info 2");
+
+    deferred_logger.appendMessages(other_logger);
+    deferred_logger.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Warning) );
+    BOOST_CHECK_EQUAL( 2 , counter->numMessages(Log::MessageType::Info) );
+
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(messageTemplates)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Info, "well P1 gets SHUT") + "\n"
+        + Log::prefixMessage(Log::MessageType::Warning, "plain warning") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "bhp 150.500000 bars for well I2 in 3 iterations") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "well P1 gets SHUT") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+
+    const int shut = DeferredLogger::messageTemplate("", "well {} gets SHUT");
+    const int bhp = DeferredLogger::messageTemplate("", "bhp {} bars for well {} in {} iterations");
+    BOOST_CHECK_EQUAL(shut, DeferredLogger::messageTemplate("", "well {} gets SHUT"));
+    BOOST_CHECK(shut != bhp);
+
+    auto deferred_logger = Opm::DeferredLogger();
+    auto other_logger = Opm::DeferredLogger();
+    deferred_logger.info(shut, "P1");
+    deferred_logger.warning("plain warning");
+    other_logger.info(bhp, 150.5, std::string("I2"), 3);
+    other_logger.info(shut, std::string("P1"));
+
+    // the arguments are copied when the loggers are combined
+    deferred_logger.appendMessages(other_logger);
+    other_logger.clearMessages();
+    deferred_logger.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL( 1 , counter->numMessages(Log::MessageType::Warning) );
+    BOOST_CHECK_EQUAL( 3 , counter->numMessages(Log::MessageType::Info) );
+
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(messageTemplatesBenchmark)
+{
+    // compare adding text messages to adding template messages, as done for
+    // each well in each Newton iteration. the logger is reused, so the
+    // template messages do not allocate once the arena has grown.
+    const int numMessages = 100000;
+    const std::string wellName = "PRODUCER-WITH-A-LONG-NAME";
+    const int shut = DeferredLogger::messageTemplate("", " well {} gets SHUT during iteration ");
+    auto deferred_logger = Opm::DeferredLogger();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numMessages; ++i) {
+        deferred_logger.debug(" well " + wellName + " gets SHUT during iteration ");
+    }
+    deferred_logger.clearMessages();
+    const std::chrono::duration<double> textTime = std::chrono::steady_clock::now() - start;
+
+    for (int round = 0; round < 2; ++round) {
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numMessages; ++i) {
+            deferred_logger.debug(shut, wellName);
+        }
+        deferred_logger.clearMessages();
+    }
+    const std::chrono::duration<double> templateTime = std::chrono::steady_clock::now() - start;
+
+    BOOST_TEST_MESSAGE("Adding " << numMessages << " text messages took " << textTime.count()
+                       << " s, template messages took " << templateTime.count() << " s");
+}
@@ -36,7 +36,12 @@
 #else
 #include <dune/common/parallel/mpihelper.hh>
 #endif
+#include <dune/common/timer.hh>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdlib>
@@ -218,6 +223,59 @@ void test_PhasePressure()
     CHECK_CLOSE(ptable.oil  (last) , 166.5e3, reltol);
 }
 
+void test_PhasePressureBatched()
+{
+    const auto record = mkEquilRecord( 0, 1e5, 5, 0, 0, 0 );
+
+    using TypeTag     = TTAG(TestEquilTypeTag);
+    using FluidSystem = GET_PROP_TYPE(TypeTag, FluidSystem);
+
+    auto simulator = initSimulator<TypeTag>("equil_base.DATA");
+    initDefaultFluidSystem<TypeTag>();
+
+    const auto region = Opm::EQUIL::EquilReg {
+        record,
+        std::make_shared<Opm::EQUIL::Miscibility::NoMixing>(),
+        std::make_shared<Opm::EQUIL::Miscibility::NoMixing>(),
+        0
+    };
+
+    auto vspan = std::array<double, 2>{};
+    {
+        auto cells = std::vector<int>(simulator->vanguard().grid().size(0));
+        std::iota(cells.begin(), cells.end(), 0);
+
+        Opm::EQUIL::Details::verticalExtent(simulator->vanguard().grid(),
+                                            cells, vspan);
+    }
+
+    auto ptable = Opm::EQUIL::Details::PressureTable<
+        FluidSystem, Opm::EQUIL::EquilReg
+    >{ 10.0 };
+
+    ptable.equilibrate(region, vspan);
+
+    // Depths above, at and below the datum and the contact, more than one
+    // chunk of the batched evaluation.
+    auto depths = std::vector<double>{ 0.0, 5.0 };
+    for (int i = 0; i <= 200; ++i) {
+        depths.push_back(vspan[0] + i*(vspan[1] - vspan[0])/200);
+    }
+
+    auto oil = std::vector<double>{};
+    auto water = std::vector<double>{};
+    ptable.oil(depths, oil);
+    ptable.water(depths, water);
+    REQUIRE(oil.size() == depths.size());
+    REQUIRE(water.size() == depths.size());
+
+    const auto reltol = 1.0e-12;
+    for (std::size_t i = 0; i < depths.size(); ++i) {
+        CHECK_CLOSE(oil[i], ptable.oil(depths[i]), reltol);
+        CHECK_CLOSE(water[i], ptable.water(depths[i]), reltol);
+    }
+}
+
 void test_CellSubset()
 {
     using PVal        = std::vector<double>;
@@ -1072,6 +1130,74 @@ void test_DeckWithSwatinit()
     }
 #endif
 }
+
+void test_EquilibrationTiming()
+{
+    typedef typename TTAG(TestEquilTypeTag) TypeTag;
+
+    const char* decks[] = {
+        "equil_deadfluids.DATA",
+        "equil_capillary.DATA",
+        "equil_capillary_overlap.DATA",
+        "equil_liveoil.DATA",
+        "equil_livegas.DATA",
+        "equil_rsvd_and_rvvd.DATA",
+        "equil_pbvd_and_pdvd.DATA",
+    };
+
+    // Every run gets its own simulator since SWATINIT would modify the
+    // material law parameters. Only the equilibration itself is timed.
+    const auto equilibrate = [](const char* deck, const int threads, double& time, int& numCells)
+    {
+        auto simulator = initSimulator<TypeTag>(deck);
+        const auto& eclipseState = simulator->vanguard().eclState();
+        auto& materialLawManager = *simulator->problem().materialLawManager();
+        const auto& grid = simulator->vanguard().grid();
+        numCells = grid.size(0);
+
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void) threads;
+#endif
+        using InitialStateComputer = Opm::EQUIL::DeckDependent::InitialStateComputer<TypeTag>;
+        Dune::Timer timer;
+        auto comp = std::make_unique<InitialStateComputer>(materialLawManager, eclipseState, grid, 9.80665);
+        time = timer.stop();
+        return comp;
+    };
+
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+    const int numThreads = std::max(maxThreads, 4);
+#endif
+    for (const auto* deck : decks) {
+        double serialTime = 0.0;
+        int numCells = 0;
+        const auto serial = equilibrate(deck, 1, serialTime, numCells);
+        std::cout << "Equilibration of " << deck << " (" << numCells << " cells): "
+                  << serialTime << " seconds with 1 thread";
+
+#ifdef _OPENMP
+        double threadedTime = 0.0;
+        const auto comp = equilibrate(deck, numThreads, threadedTime, numCells);
+        std::cout << ", " << threadedTime << " seconds with " << numThreads << " threads";
+
+        // the cells are independent, so the result must not depend on the
+        // number of threads.
+        for (std::size_t phase = 0; phase < comp->press().size(); ++phase) {
+            REQUIRE(comp->press()[phase] == serial->press()[phase]);
+            REQUIRE(comp->saturation()[phase] == serial->saturation()[phase]);
+        }
+        REQUIRE(comp->rs() == serial->rs());
+        REQUIRE(comp->rv() == serial->rv());
+#endif
+        std::cout << std::endl;
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+}
 }
 
 int main(int argc, char** argv)
@@ -1086,6 +1212,7 @@ try {
     Opm::registerAllParameters_<TypeTag>();
 
     test_PhasePressure();
+    test_PhasePressureBatched();
     test_CellSubset();
     test_RegMapping();
     test_DeckAllDead();
@@ -1097,6 +1224,7 @@ try {
     test_DeckWithRSVDAndRVVD();
     test_DeckWithPBVDAndPDVD();
     test_DeckWithSwatinit();
+    test_EquilibrationTiming();
 }
 catch (const std::exception& e) {
     std::cerr << "Unexpected Termination: " << e.what() << '\n';
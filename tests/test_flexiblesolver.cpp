@@ -126,6 +126,29 @@ BOOST_AUTO_TEST_CASE(TestFlexibleSolver)
     }
 }
 
+BOOST_AUTO_TEST_CASE(TestPipelinedBiCGSTAB)
+{
+    namespace pt = boost::property_tree;
+    pt::ptree prm;
+    prm.put("tol", 1e-12);
+    prm.put("maxiter", 200);
+    prm.put("verbosity", 0);
+    prm.put("solver", "pipelinedbicgstab");
+    prm.put("preconditioner.type", "ILU0");
+
+    const int bz = 3;
+    auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    Dune::BlockVector<Dune::FieldVector<double, bz>> expected {{-1.62493, -1.76435e-06, 1.86991e-10},
+                                                               {-458.542, 2.28308e-06, -2.45341e-07},
+                                                               {-1.48005, -5.02264e-07, -1.049e-05}};
+    BOOST_REQUIRE_EQUAL(sol.size(), expected.size());
+    for (size_t i = 0; i < sol.size(); ++i) {
+        for (int row = 0; row < bz; ++row) {
+            BOOST_CHECK_CLOSE(sol[i][row], expected[i][row], 1e-3);
+        }
+    }
+}
+
 #else
 
 // Do nothing if we do not have at least Dune 2.6.
@@ -166,6 +166,43 @@ BOOST_AUTO_TEST_CASE(AllHaveOneMessage)
     }
 }
 
+BOOST_AUTO_TEST_CASE(MessageTemplates)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+
+    // the templates are interned in a different order on each rank, so their
+    // ids differ between the ranks
+    const std::string text = "well W{} on rank {} has bhp {}";
+    const std::string other_text = "unused on rank {}";
+    if (cc.rank() % 2 == 1) {
+        DeferredLogger::messageTemplate("", other_text);
+    }
+    const int message = DeferredLogger::messageTemplate("", text);
+
+    Opm::DeferredLogger local_deferredlogger;
+    local_deferredlogger.info(message, cc.rank(), std::to_string(cc.rank()), 1.5);
+
+    Opm::DeferredLogger global_deferredlogger = gatherDeferredLogger(local_deferredlogger);
+
+    if (cc.rank() == 0) {
+
+        global_deferredlogger.logMessages();
+
+        auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+        BOOST_CHECK_EQUAL( cc.size() , counter->numMessages(Log::MessageType::Info) );
+
+        std::string expected;
+        for (int i=0; i<cc.size(); i++) {
+            expected += Log::prefixMessage(Log::MessageType::Info, "well W" + std::to_string(i) + " on rank "
+                                           + std::to_string(i) + " has bhp 1.500000") + "\n";
+        }
+        BOOST_CHECK_EQUAL(log_stream.str(), expected);
+    }
+}
+
 int main(int argc, char** argv)
 {
     Dune::MPIHelper::instance(argc, argv);
@@ -0,0 +1,66 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestMaxSumReduction
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/MaxSumReduction.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(MaxAndSums)
+{
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    const int rank = comm.rank();
+    const int size = comm.size();
+
+    std::vector<double> values{double(rank), 1.0, double(rank), -2.0};
+    Opm::reduceMaxAndSums(comm, values);
+
+    BOOST_CHECK_EQUAL(values[0], size - 1);
+    BOOST_CHECK_EQUAL(values[1], size);
+    BOOST_CHECK_EQUAL(values[2], size*(size - 1)/2);
+    BOOST_CHECK_EQUAL(values[3], -2.0*size);
+}
+
+BOOST_AUTO_TEST_CASE(MaxOnly)
+{
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    std::vector<double> values{-1.0 - comm.rank()};
+    Opm::reduceMaxAndSums(comm, values);
+
+    BOOST_CHECK_EQUAL(values[0], -1.0);
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
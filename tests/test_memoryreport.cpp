@@ -0,0 +1,104 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestMemoryReport
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/MemoryReport.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Behaves like the collective communication of three processes which all
+// hold the same data.
+struct ThreeProcessComm
+{
+    int size() const
+    { return 3; }
+
+    template<class T>
+    void sum(T* data, int n) const
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] *= 3;
+    }
+
+    template<class T>
+    void max(T*, int) const
+    {}
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(AddAndTotal)
+{
+    Opm::MemoryReport report;
+    report.add("Grid", 100);
+    report.add("Jacobian", 50);
+    report.add("Grid", 20);
+
+    BOOST_CHECK_EQUAL(report.bytes("Grid"), 120U);
+    BOOST_CHECK_EQUAL(report.bytes("Jacobian"), 50U);
+    BOOST_CHECK_EQUAL(report.bytes("Preconditioner"), 0U);
+    BOOST_CHECK_EQUAL(report.totalBytes(), 170U);
+
+    // the subsystems are listed in the order they were added
+    const std::string table = report.str("Memory");
+    BOOST_CHECK(table.find("Grid") < table.find("Jacobian"));
+    BOOST_CHECK(table.find("Accounted") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Reduce)
+{
+    Opm::MemoryReport report;
+    report.add("Grid", 3*1024*1024);
+    report.reduce(ThreeProcessComm());
+
+    BOOST_CHECK_EQUAL(report.bytes("Grid"), 3U*1024*1024);
+    const std::string table = report.str("Memory");
+    BOOST_CHECK(table.find("max/process") != std::string::npos);
+    BOOST_CHECK(table.find("9.0") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ContainerSizes)
+{
+    std::vector<double> values(10);
+    BOOST_CHECK_EQUAL(Opm::memoryUsageOf(values), values.capacity()*sizeof(double));
+    values.clear();
+    values.shrink_to_fit();
+    BOOST_CHECK_EQUAL(Opm::memoryUsageOf(values), 0U);
+
+    using Block = Dune::FieldMatrix<double, 3, 3>;
+    using Matrix = Dune::BCRSMatrix<Block>;
+    Matrix matrix(2, 2, 3, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        row.insert(0);
+        if (row.index() == 1)
+            row.insert(1);
+    }
+    BOOST_CHECK_EQUAL(Opm::matrixMemoryUsage(matrix),
+                      3*(sizeof(Block) + sizeof(Matrix::size_type)) + 2*sizeof(Matrix::row_type));
+}
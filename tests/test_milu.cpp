@@ -196,3 +196,45 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+// An update after the values of the matrix changed must yield the same
+// preconditioner as a new setup, also with reordering and fill-in.
+void testRefactorization(int n, bool redBlack)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2> >;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 2> >;
+    Matrix A;
+    setupLaplacian(A, 8);
+
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> updated(A, n, 1.0, Opm::MILU_VARIANT::ILU, redBlack);
+
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col *= 1.0 + 0.01*row.index();
+        }
+        (*row)[row.index()][0][1] = 0.5;
+    }
+    updated.update();
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> fresh(A, n, 1.0, Opm::MILU_VARIANT::ILU, redBlack);
+
+    Vector d(A.N()), x1(A.N()), x2(A.N());
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i][0] = 1.0 + i;
+        d[i][1] = 1.0 - 0.5*i;
+    }
+    x1 = 0.0;
+    x2 = 0.0;
+    updated.apply(x1, d);
+    fresh.apply(x2, d);
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        BOOST_CHECK_CLOSE(x1[i][0], x2[i][0], 1e-10);
+        BOOST_CHECK_CLOSE(x1[i][1], x2[i][1], 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILURefactorization)
+{
+    testRefactorization(0, false);
+    testRefactorization(0, true);
+    testRefactorization(1, false);
+}
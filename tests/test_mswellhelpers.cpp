@@ -0,0 +1,195 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MSWellHelpersTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/MSWellHelpers.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int numWellEq = 4;
+using Block = Dune::FieldMatrix<double, numWellEq, numWellEq>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, numWellEq>>;
+
+// A stem of segments with a lateral branch of the given length attached
+// to every branch_interval-th stem segment, the layout of tests/msw.data
+// repeated along the well. Returns the inlets of each segment.
+std::vector<std::vector<int>> makeSegmentTree(const int num_stem, const int branch_interval, const int branch_length)
+{
+    std::vector<std::vector<int>> inlets(num_stem);
+    for (int seg = 1; seg < num_stem; ++seg) {
+        inlets[seg - 1].push_back(seg);
+    }
+    for (int seg = branch_interval; seg < num_stem; seg += branch_interval) {
+        int outlet = seg;
+        for (int i = 0; i < branch_length; ++i) {
+            const int branch_seg = inlets.size();
+            inlets.emplace_back();
+            inlets[outlet].push_back(branch_seg);
+            outlet = branch_seg;
+        }
+    }
+    return inlets;
+}
+
+// D with the sparsity pattern of MultisegmentWell::initMatrixAndVectors()
+Matrix makeSegmentMatrix(const std::vector<std::vector<int>>& inlets)
+{
+    const int num_seg = inlets.size();
+    std::vector<int> outlet(num_seg, -1);
+    int nnz = num_seg;
+    for (int seg = 0; seg < num_seg; ++seg) {
+        for (const int inlet : inlets[seg]) {
+            outlet[inlet] = seg;
+        }
+        nnz += 2 * inlets[seg].size();
+    }
+
+    Matrix D(num_seg, num_seg, nnz, Matrix::row_wise);
+    for (auto row = D.createbegin(); row != D.createend(); ++row) {
+        const int seg = row.index();
+        if (outlet[seg] >= 0) {
+            row.insert(outlet[seg]);
+        }
+        row.insert(seg);
+        for (const int inlet : inlets[seg]) {
+            row.insert(inlet);
+        }
+    }
+
+    for (auto row = D.begin(); row != D.end(); ++row) {
+        const int seg = row.index();
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            const int col_seg = col.index();
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numWellEq; ++j) {
+                    const double value = 0.05 * ((7 * seg + 3 * col_seg + 5 * i + 11 * j) % 13) - 0.3;
+                    (*col)[i][j] = (col_seg == seg && i == j) ? 10.0 + value : value;
+                }
+            }
+        }
+    }
+    return D;
+}
+
+Vector makeRhs(const int num_seg)
+{
+    Vector x(num_seg);
+    for (int seg = 0; seg < num_seg; ++seg) {
+        for (int i = 0; i < numWellEq; ++i) {
+            x[seg][i] = 1.0 + ((seg + 2 * i) % 5);
+        }
+    }
+    return x;
+}
+
+void checkSolution(const Matrix& D, const Vector& y, const Vector& x)
+{
+    Vector residual = x;
+    D.mmv(y, residual);
+    BOOST_CHECK_SMALL(residual.infinity_norm(), 1e-10 * x.infinity_norm());
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolveSegmentTree)
+{
+    const auto inlets = makeSegmentTree(8, 3, 2);
+    const Matrix D = makeSegmentMatrix(inlets);
+    const Vector x = makeRhs(D.N());
+
+    Opm::mswellhelpers::SegmentTreeSolver<Matrix, Vector> solver;
+    BOOST_CHECK(!solver.factorized());
+    BOOST_REQUIRE(solver.factorize(D, inlets));
+    BOOST_CHECK(solver.factorized());
+    checkSolution(D, solver.solve(x), x);
+}
+
+BOOST_AUTO_TEST_CASE(RejectNonTreeTopology)
+{
+    auto inlets = makeSegmentTree(8, 3, 2);
+    const Matrix D = makeSegmentMatrix(inlets);
+    Opm::mswellhelpers::SegmentTreeSolver<Matrix, Vector> solver;
+
+    // a segment with two outlets
+    auto two_outlets = inlets;
+    two_outlets[1].push_back(inlets[0][0] + 2);
+    BOOST_CHECK(!solver.factorize(D, two_outlets));
+    BOOST_CHECK(!solver.factorized());
+
+    // a segment which is not connected to the top segment
+    auto disconnected = inlets;
+    disconnected[2].clear();
+    BOOST_CHECK(!solver.factorize(D, disconnected));
+}
+
+BOOST_AUTO_TEST_CASE(RejectSingularPivot)
+{
+    const auto inlets = makeSegmentTree(4, 2, 1);
+    Matrix D = makeSegmentMatrix(inlets);
+    D[3][3] = 0.0;
+    Opm::mswellhelpers::SegmentTreeSolver<Matrix, Vector> solver;
+    BOOST_CHECK(!solver.factorize(D, inlets));
+    BOOST_CHECK(!solver.factorized());
+
+    // a rank deficient pivot block without any zero pivot, two equal rows
+    D = makeSegmentMatrix(inlets);
+    D[3][3][1] = D[3][3][0];
+    BOOST_CHECK(!solver.factorize(D, inlets));
+    BOOST_CHECK(!solver.factorized());
+}
+
+BOOST_AUTO_TEST_CASE(ManySegments)
+{
+    const auto inlets = makeSegmentTree(2000, 10, 20);
+    const Matrix D = makeSegmentMatrix(inlets);
+    const Vector x = makeRhs(D.N());
+
+    Dune::Timer timer;
+    Opm::mswellhelpers::SegmentTreeSolver<Matrix, Vector> solver;
+    BOOST_REQUIRE(solver.factorize(D, inlets));
+    const Vector y = solver.solve(x);
+    BOOST_TEST_MESSAGE("SegmentTreeSolver, " + std::to_string(D.N()) + " segments: "
+                       + std::to_string(timer.stop()) + " sec");
+    checkSolution(D, y, x);
+
+#if HAVE_UMFPACK
+    timer.reset();
+    timer.start();
+    const Vector y_umfpack = Opm::mswellhelpers::invDXDirect(D, x);
+    BOOST_TEST_MESSAGE("UMFPack, " + std::to_string(D.N()) + " segments: "
+                       + std::to_string(timer.stop()) + " sec");
+    Vector diff = y;
+    diff -= y_umfpack;
+    BOOST_CHECK_SMALL(diff.infinity_norm(), 1e-10 * y.infinity_norm());
+#endif // HAVE_UMFPACK
+}
@@ -27,6 +27,8 @@
 #include <boost/test/unit_test.hpp>
 #include "DuneIstlTestHelpers.hpp"
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bvector.hh>
 #include <functional>
 #ifdef HAVE_DUNE_ISTL
 
@@ -100,4 +102,70 @@ BOOST_AUTO_TEST_CASE(singleContainerReductionTest)
     comm.computeReduction(x,Opm::Reduction::makeGlobalSumFunctor<int>(),value);
     BOOST_CHECK(value==oldvalue+((N-1)*N)/2);
 }
+
+template<class I>
+void setOwnerValues(const I& indexSet, std::vector<double>& x,
+                    Dune::BlockVector<Dune::FieldVector<double,2> >& y, int offset)
+{
+    x.resize(indexSet.size());
+    y.resize(indexSet.size());
+    for(auto it=indexSet.begin(), itend=indexSet.end(); it!=itend; ++it)
+    {
+        bool owner = it->local().attribute()==Dune::OwnerOverlapCopyAttributeSet::owner;
+        x[it->local()] = owner ? it->global()+offset : -1;
+        y[it->local()] = owner ? it->global()-offset : -1;
+    }
+}
+
+template<class I>
+void checkOwnerValues(const I& indexSet, const std::vector<double>& x,
+                      const Dune::BlockVector<Dune::FieldVector<double,2> >& y, int offset)
+{
+    for(auto it=indexSet.begin(), itend=indexSet.end(); it!=itend; ++it)
+    {
+        BOOST_CHECK(x[it->local()]==it->global()+offset);
+        BOOST_CHECK(y[it->local()][0]==it->global()-offset);
+        BOOST_CHECK(y[it->local()][1]==it->global()-offset);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copyOwnerToAllTest)
+{
+    int N=100;
+    int start, end, istart, iend;
+    std::tie(start,istart,iend,end) = computeRegions(N);
+    Opm::ParallelISTLInformation comm(MPI_COMM_WORLD);
+    auto& indexSet = *comm.indexSet();
+    auto mat = create1DLaplacian(indexSet, N, start, end, istart, iend);
+    // The communication is reused between the calls and for copies of
+    // the information, with a different communicator for each block size.
+    Opm::ParallelISTLInformation copy(comm);
+    std::vector<double> x;
+    Dune::BlockVector<Dune::FieldVector<double,2> > y;
+    for(int repeat=0; repeat<3; ++repeat)
+    {
+        setOwnerValues(indexSet, x, y, repeat);
+        comm.copyOwnerToAll(x,x);
+        copy.copyOwnerToAll(y,y);
+        checkOwnerValues(indexSet, x, y, repeat);
+    }
+
+    // A new decomposition changes the sequence number of the index set,
+    // which has to set up the communication again.
+    indexSet.beginResize();
+    for(auto it=indexSet.begin(), itend=indexSet.end(); it!=itend; ++it)
+        indexSet.markAsDeleted(it);
+    indexSet.endResize();
+    N=60;
+    std::tie(start,istart,iend,end) = computeRegions(N);
+    mat = create1DLaplacian(indexSet, N, start, end, istart, iend);
+    BOOST_REQUIRE(indexSet.size()==static_cast<std::size_t>(end-start));
+    for(int repeat=0; repeat<2; ++repeat)
+    {
+        setOwnerValues(indexSet, x, y, repeat);
+        copy.copyOwnerToAll(x,x);
+        comm.copyOwnerToAll(y,y);
+        checkOwnerValues(indexSet, x, y, repeat);
+    }
+}
 #endif
@@ -0,0 +1,93 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestPartitionCells
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/partitionCells.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// The neighbor lists of a two-dimensional Cartesian grid with nx*ny cells.
+void cartesianNeighbors(int nx, int ny, std::vector<int>& neighborStart, std::vector<int>& neighbors)
+{
+    neighborStart.assign(1, 0);
+    neighbors.clear();
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            if (i > 0)
+                neighbors.push_back(j*nx + i - 1);
+            if (i < nx - 1)
+                neighbors.push_back(j*nx + i + 1);
+            if (j > 0)
+                neighbors.push_back((j - 1)*nx + i);
+            if (j < ny - 1)
+                neighbors.push_back((j + 1)*nx + i);
+            neighborStart.push_back(neighbors.size());
+        }
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Chain)
+{
+    std::vector<int> neighborStart, neighbors;
+    cartesianNeighbors(10, 1, neighborStart, neighbors);
+
+    const auto domain = Opm::partitionCells(3, neighborStart, neighbors);
+    const std::vector<int> expected = {0, 0, 0, 0, 1, 1, 1, 2, 2, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(domain.begin(), domain.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Cartesian)
+{
+    std::vector<int> neighborStart, neighbors;
+    cartesianNeighbors(6, 5, neighborStart, neighbors);
+
+    const int numDomains = 4;
+    const auto domain = Opm::partitionCells(numDomains, neighborStart, neighbors);
+    BOOST_REQUIRE_EQUAL(domain.size(), 30U);
+    for (int domainIdx = 0; domainIdx < numDomains; ++domainIdx) {
+        const auto size = std::count(domain.begin(), domain.end(), domainIdx);
+        BOOST_CHECK(size == 7 || size == 8);
+    }
+    BOOST_CHECK(std::none_of(domain.begin(), domain.end(), [](int d) { return d < 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(Disconnected)
+{
+    // two separate chains of three cells
+    const std::vector<int> neighborStart = {0, 1, 3, 4, 5, 7, 8};
+    const std::vector<int> neighbors = {1, 0, 2, 1, 4, 3, 5, 4};
+
+    const auto domain = Opm::partitionCells(2, neighborStart, neighbors);
+    const std::vector<int> expected = {0, 0, 0, 1, 1, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(domain.begin(), domain.end(), expected.begin(), expected.end());
+
+    // more domains than cells
+    const auto single = Opm::partitionCells(10, neighborStart, neighbors);
+    const std::vector<int> expectedSingle = {0, 1, 2, 3, 4, 5};
+    BOOST_CHECK_EQUAL_COLLECTIONS(single.begin(), single.end(), expectedSingle.begin(), expectedSingle.end());
+}
@@ -0,0 +1,118 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestRankCheckpoint
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/RankCheckpoint.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Two processes sharing the global cells 0..5, cells 2 and 3 are in the
+// overlap. Rank 0 owns 0..2, rank 1 owns 3..5.
+Opm::RankCheckpoint makeCheckpoint(int rank)
+{
+    Opm::RankCheckpoint checkpoint;
+    checkpoint.reportStep = 3;
+    checkpoint.rank = rank;
+    checkpoint.numRanks = 2;
+    if (rank == 0) {
+        checkpoint.globalIndex = {0, 1, 2, 3};
+        checkpoint.interior = {1, 1, 1, 0};
+    }
+    else {
+        checkpoint.globalIndex = {5, 4, 3, 2};
+        checkpoint.interior = {1, 1, 1, 0};
+    }
+
+    std::vector<double> pressure;
+    for (const int globalIdx : checkpoint.globalIndex)
+        pressure.push_back(rank == 0 || globalIdx != 2 ? 100.0 + globalIdx : -1.0);
+    checkpoint.restartValue.solution.insert("PRESSURE", Opm::UnitSystem::measure::pressure,
+                                            pressure, Opm::data::TargetType::RESTART_SOLUTION);
+    checkpoint.restartValue.wells["W" + std::to_string(rank)] = Opm::data::Well();
+    checkpoint.restartValue.addExtra("OPMEXTRA", std::vector<double>(1, 10.0 + rank));
+    checkpoint.summaryState = {'s', static_cast<char>('0' + rank)};
+    return checkpoint;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(WriteAndRead)
+{
+    const Opm::RankCheckpoint checkpoint = makeCheckpoint(1);
+    const std::string fileName = Opm::rankCheckpointFileName("RANKCHK_RW", checkpoint.reportStep, checkpoint.rank);
+    BOOST_CHECK_EQUAL(fileName, "RANKCHK_RW.0003.00001.OPMCHK");
+    Opm::writeRankCheckpoint(fileName, checkpoint);
+
+    Opm::RankCheckpoint loaded;
+    BOOST_REQUIRE(Opm::readRankCheckpoint(fileName, loaded));
+    BOOST_CHECK_EQUAL(loaded.reportStep, checkpoint.reportStep);
+    BOOST_CHECK_EQUAL(loaded.rank, checkpoint.rank);
+    BOOST_CHECK_EQUAL(loaded.numRanks, checkpoint.numRanks);
+    BOOST_CHECK(loaded.globalIndex == checkpoint.globalIndex);
+    BOOST_CHECK(loaded.interior == checkpoint.interior);
+    BOOST_CHECK(loaded.restartValue == checkpoint.restartValue);
+    BOOST_CHECK(loaded.summaryState == checkpoint.summaryState);
+
+    BOOST_CHECK(!Opm::readRankCheckpoint("RANKCHK_MISSING.0003.00001.OPMCHK", loaded));
+}
+
+BOOST_AUTO_TEST_CASE(Merge)
+{
+    for (int rank = 0; rank < 2; ++rank)
+        Opm::writeRankCheckpoint(Opm::rankCheckpointFileName("RANKCHK_MERGE", 3, rank), makeCheckpoint(rank));
+
+    Opm::RankCheckpoint merged;
+    BOOST_REQUIRE(Opm::mergeRankCheckpoints("RANKCHK_MERGE", 3, 6, merged));
+    const auto& pressure = merged.restartValue.solution.at("PRESSURE").data;
+    BOOST_REQUIRE_EQUAL(pressure.size(), 6U);
+    for (int globalIdx = 0; globalIdx < 6; ++globalIdx)
+        BOOST_CHECK_EQUAL(pressure[globalIdx], 100.0 + globalIdx);
+
+    BOOST_CHECK_EQUAL(merged.restartValue.wells.size(), 2U);
+    BOOST_CHECK_EQUAL(merged.restartValue.getExtra("OPMEXTRA")[0], 10.0);
+    BOOST_CHECK(merged.summaryState == makeCheckpoint(0).summaryState);
+
+    // the checkpoint of rank 1 is missing for this step
+    auto checkpoint = makeCheckpoint(0);
+    checkpoint.reportStep = 4;
+    Opm::writeRankCheckpoint(Opm::rankCheckpointFileName("RANKCHK_MERGE", 4, 0), checkpoint);
+    BOOST_CHECK(!Opm::mergeRankCheckpoints("RANKCHK_MERGE", 4, 6, merged));
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
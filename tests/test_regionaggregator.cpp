@@ -0,0 +1,137 @@
+/*
+  Copyright 2020 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestRegionAggregator
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/RegionAggregator.hpp>
+
+#include <vector>
+
+namespace {
+
+// Behaves like the collective communication of a process which is
+// alone, except that it counts the reductions.
+struct SerialComm
+{
+    template<class T>
+    T max(T value) const
+    { return value; }
+
+    template<class T>
+    void sum(T*, int) const
+    { ++numSums; }
+
+    mutable int numSums = 0;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(SumArrays)
+{
+    SerialComm comm;
+    // the cell with the negative region is not summed
+    const std::vector<int> cellRegion = {1, 0, -1, 1, 2, 0};
+    Opm::RegionAggregator aggregator(cellRegion, comm);
+    BOOST_CHECK_EQUAL(aggregator.numRegions(), 3U);
+
+    const std::vector<double> volume = {1.0, 2.0, 4.0, 8.0, 16.0, 32.0};
+    const std::vector<double> empty;
+    const std::vector<double> ones(cellRegion.size(), 1.0);
+    aggregator.sum(std::vector<const std::vector<double>*>{&volume, &empty, &ones}, comm);
+    BOOST_CHECK_EQUAL(comm.numSums, 1);
+
+    const std::vector<double> expectedVolume = {34.0, 9.0, 16.0};
+    const std::vector<double> volumeTotals = aggregator.totals(0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(volumeTotals.begin(), volumeTotals.end(),
+                                  expectedVolume.begin(), expectedVolume.end());
+    for (std::size_t region = 0; region < aggregator.numRegions(); ++region)
+        BOOST_CHECK_EQUAL(aggregator.total(1, region), 0.0);
+    BOOST_CHECK_EQUAL(aggregator.total(2, 0), 2.0);
+    BOOST_CHECK_EQUAL(aggregator.total(2, 1), 2.0);
+    BOOST_CHECK_EQUAL(aggregator.total(2, 2), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(SumOnTheFly)
+{
+    SerialComm comm;
+    const std::vector<int> cellRegion = {0, 1, 1, -1};
+    Opm::RegionAggregator aggregator(cellRegion, comm);
+
+    aggregator.beginSum(2, /*numThreads=*/1);
+    for (std::size_t cellIdx = 0; cellIdx < cellRegion.size(); ++cellIdx) {
+        double* sums = aggregator.partialSums(/*threadId=*/0, cellIdx);
+        if (cellRegion[cellIdx] < 0) {
+            BOOST_CHECK(sums == nullptr);
+            continue;
+        }
+        sums[0] += 1.0;
+        sums[1] += cellIdx;
+    }
+    aggregator.endSum(comm);
+    BOOST_CHECK_EQUAL(comm.numSums, 1);
+
+    BOOST_CHECK_EQUAL(aggregator.total(0, 0), 1.0);
+    BOOST_CHECK_EQUAL(aggregator.total(1, 0), 0.0);
+    BOOST_CHECK_EQUAL(aggregator.total(0, 1), 2.0);
+    BOOST_CHECK_EQUAL(aggregator.total(1, 1), 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(CellLists)
+{
+    SerialComm comm;
+    const std::vector<int> cellRegion = {2, 0, -1, 2, 1, 0};
+    Opm::RegionAggregator aggregator(cellRegion, comm);
+
+    // the cells of each region are contiguous and the regions ascending
+    const std::vector<std::size_t> expectedCells = {1, 5, 4, 0, 3};
+    BOOST_REQUIRE_EQUAL(aggregator.numEntries(), expectedCells.size());
+    for (std::size_t entryIdx = 0; entryIdx < expectedCells.size(); ++entryIdx)
+        BOOST_CHECK_EQUAL(aggregator.cell(entryIdx), expectedCells[entryIdx]);
+}
+
+BOOST_AUTO_TEST_CASE(SumInThreadOrder)
+{
+    SerialComm comm;
+    const std::vector<int> cellRegion = {0, 0, 0, 0};
+    Opm::RegionAggregator aggregator(cellRegion, comm);
+
+    // values whose sum depends on the order of the additions
+    const std::vector<double> values = {1.0, 1e16, -1e16, 1.0};
+    double expected = 0.0;
+    for (std::size_t threadId = 0; threadId < 2; ++threadId) {
+        double threadSum = 0.0;
+        for (std::size_t entryIdx = 2*threadId; entryIdx < 2*threadId + 2; ++entryIdx)
+            threadSum += values[aggregator.cell(entryIdx)];
+        expected += threadSum;
+    }
+
+    // the second thread finishes first, the result is the same
+    aggregator.beginSum(1, /*numThreads=*/2);
+    for (int threadId = 1; threadId >= 0; --threadId) {
+        for (std::size_t entryIdx = 2*threadId; entryIdx < 2*threadId + 2; ++entryIdx) {
+            const std::size_t cellIdx = aggregator.cell(entryIdx);
+            aggregator.partialSums(threadId, cellIdx)[0] += values[cellIdx];
+        }
+    }
+    aggregator.endSum(comm);
+    BOOST_CHECK_EQUAL(aggregator.total(0, 0), expected);
+}